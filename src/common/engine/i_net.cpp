@@ -75,6 +75,8 @@
 #include "cmdlib.h"
 #include "printf.h"
 #include "i_interface.h"
+#include "c_cvars.h"
+#include "stats.h"
 
 
 #include "i_net.h"
@@ -107,6 +109,17 @@ typedef int socklen_t;
 bool netgame, multiplayer;
 int consoleplayer; // i.e. myconnectindex in Build. 
 doomcom_t doomcom;
+FNetNodeStats netnodestats[MAXNETNODES];
+
+// Game packets are small, so the higher zlib levels barely shrink them further
+// but cost noticeably more CPU per packet. The receiving end does not care
+// which level was used. 0 disables compression of outgoing packets, except
+// for those too large to be sent uncompressed.
+CUSTOM_CVAR(Int, net_compresslevel, 1, CVAR_ARCHIVE|CVAR_GLOBALCONFIG)
+{
+	if (self < 0) self = 0;
+	else if (self > 9) self = 9;
+}
 
 //
 // NETWORKING
@@ -233,12 +246,17 @@ void PacketSend (void)
 	}
 	assert(!(doomcom.data[0] & NCMD_COMPRESSED));
 
+	FNetNodeStats &stats = netnodestats[doomcom.remotenode];
 	uLong size = TRANSMIT_SIZE - 1;
-	if (doomcom.datalength >= 10)
+	if (doomcom.datalength > TRANSMIT_SIZE || (doomcom.datalength >= 10 && net_compresslevel > 0))
 	{
+		cycle_t ctime;
+		ctime.ResetAndClock();
 		TransmitBuffer[0] = doomcom.data[0] | NCMD_COMPRESSED;
-		c = compress2(TransmitBuffer + 1, &size, doomcom.data + 1, doomcom.datalength - 1, 9);
+		c = compress2(TransmitBuffer + 1, &size, doomcom.data + 1, doomcom.datalength - 1, max<int>(net_compresslevel, 1));
 		size += 1;
+		ctime.Unclock();
+		stats.CompressMS += ctime.TimeMS();
 	}
 	else
 	{
@@ -250,6 +268,7 @@ void PacketSend (void)
 		c = sendto(mysocket, (char *)TransmitBuffer, size,
 			0, (sockaddr *)&sendaddress[doomcom.remotenode],
 			sizeof(sendaddress[doomcom.remotenode]));
+		stats.BytesSent += size;
 	}
 	else
 	{
@@ -263,13 +282,24 @@ void PacketSend (void)
 			c = sendto(mysocket, (char *)doomcom.data, doomcom.datalength,
 				0, (sockaddr *)&sendaddress[doomcom.remotenode],
 				sizeof(sendaddress[doomcom.remotenode]));
+			stats.BytesSent += doomcom.datalength;
 		}
 	}
+	stats.PacketsSent++;
+	stats.RawBytesSent += doomcom.datalength;
 	//	if (c == -1)
 	//			I_Error ("SendPacket error: %s",strerror(errno));
 }
 
 
+//
+// I_ClearNetStats
+//
+void I_ClearNetStats (void)
+{
+	memset (netnodestats, 0, sizeof(netnodestats));
+}
+
 //
 // PacketGet
 //
@@ -318,11 +348,18 @@ void PacketGet (void)
 	}
 	else if (node >= 0 && c > 0)
 	{
+		FNetNodeStats &stats = netnodestats[node];
+		stats.PacketsRecv++;
+		stats.BytesRecv += c;
 		doomcom.data[0] = TransmitBuffer[0] & ~NCMD_COMPRESSED;
 		if (TransmitBuffer[0] & NCMD_COMPRESSED)
 		{
 			uLongf msgsize = MAX_MSGLEN - 1;
+			cycle_t ctime;
+			ctime.ResetAndClock();
 			int err = uncompress(doomcom.data + 1, &msgsize, TransmitBuffer + 1, c - 1);
+			ctime.Unclock();
+			stats.DecompressMS += ctime.TimeMS();
 //			Printf("recv %d/%lu\n", c, msgsize + 1);
 			if (err != Z_OK)
 			{
@@ -338,6 +375,7 @@ void PacketGet (void)
 //			Printf("recv %d\n", c);
 			memcpy(doomcom.data + 1, TransmitBuffer + 1, c - 1);
 		}
+		stats.RawBytesRecv += c;
 	}
 	else if (c > 0)
 	{	//The packet is not from any in-game node, so we might as well discard it.
@@ -88,4 +88,19 @@ extern doomcom_t doomcom;
 extern bool netgame, multiplayer;
 extern int consoleplayer;
 
+//
+// Per-node traffic counters, maintained by PacketSend and PacketGet.
+// Raw sizes are before compression (sending) or after decompression (receiving).
+//
+struct FNetNodeStats
+{
+	uint64_t	PacketsSent, PacketsRecv;
+	uint64_t	BytesSent, BytesRecv;
+	uint64_t	RawBytesSent, RawBytesRecv;
+	double		CompressMS, DecompressMS;
+};
+
+extern FNetNodeStats netnodestats[MAXNETNODES];
+void I_ClearNetStats();
+
 #endif
@@ -289,6 +289,31 @@ void FRandom::StaticWriteRNGState (FSerializer &arc)
 	}
 }
 
+//==========================================================================
+//
+// FRandom :: StaticHashRNGState
+//
+// Folds the state of every named RNG into a CRC. This covers the same
+// RNGs as StaticWriteRNGState but is cheap enough to be called every tic.
+// Only the index and the head of the state array are hashed: the array
+// is only regenerated when the index wraps, so this is enough to detect
+// any difference in the number of calls made to an RNG.
+//
+//==========================================================================
+
+uint32_t FRandom::StaticHashRNGState (uint32_t crc)
+{
+	for (FRandom *rng = FRandom::RNGList; rng != NULL; rng = rng->Next)
+	{
+		if (rng->NameCRC != 0)
+		{
+			uint32_t state[6] = { rng->NameCRC, uint32_t(rng->idx), rng->sfmt.u[0], rng->sfmt.u[1], rng->sfmt.u[2], rng->sfmt.u[3] };
+			crc = AddCRC32 (crc, (const uint8_t *)state, sizeof(state));
+		}
+	}
+	return crc;
+}
+
 //==========================================================================
 //
 // FRandom :: StaticReadRNGState
@@ -170,6 +170,7 @@ public:
 	static void StaticClearRandom ();
 	static void StaticReadRNGState (FSerializer &arc);
 	static void StaticWriteRNGState (FSerializer &file);
+	static uint32_t StaticHashRNGState (uint32_t crc);
 	static FRandom *StaticFindRNG(const char *name);
 
 #ifndef NDEBUG
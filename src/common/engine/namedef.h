@@ -43,6 +43,9 @@ xx(FRandomPick)
 xx(SetRandomSeed)
 xx(BuiltinRandomSeed)
 xx(BuiltinNew)
+xx(BuiltinNewScoped)
+xx(BuiltinScopeMark)
+xx(BuiltinScopeRelease)
 xx(GetClass)
 xx(GetParentClass)
 xx(GetClassName)
@@ -167,6 +167,8 @@ FStepStats StepStats;
 FStepStats PrevStepStats;
 bool FinalGC;
 bool HadToDestroy;
+TArray<DObject *> ScopedObjects;
+size_t ScopedReleased;
 
 // PRIVATE DATA DEFINITIONS ------------------------------------------------
 
@@ -186,6 +188,12 @@ static cycle_t GCTime;			// Track time spent in GC
 
 void CheckGC()
 {
+	// No script is running here, so any scoped objects left were created
+	// by functions that aborted before they could release them.
+	if (ScopedObjects.Size() > 0)
+	{
+		ReleaseScoped(0);
+	}
 	AllocHistory.AddAlloc(RunningAllocBytes);
 	RunningAllocBytes = 0;
 	if (State > GCS_Pause || AllocBytes >= Threshold)
@@ -389,6 +397,9 @@ static void MarkRoot()
 
 	for (auto func : markers) func();
 
+	// Scoped objects are only referenced from VM registers, which are not scanned.
+	MarkArray(ScopedObjects);
+
 	// Mark soft roots.
 	if (SoftRoots != nullptr)
 	{
@@ -708,6 +719,90 @@ void DelSoftRoot(DObject *obj)
 	}
 }
 
+//==========================================================================
+//
+// ReleaseScoped
+//
+// Called when a function that created scoped objects returns. Nothing can
+// reference them anymore, so they are destroyed and freed right away
+// instead of being left for the collector to find. Entries the marker
+// has cleared belong to objects that were destroyed explicitly; those
+// are still on the object list and get swept normally.
+//
+// New objects are linked in at the head of the object list, so the ones
+// to free are all found by a single walk that ends as soon as the last
+// of them has been unlinked. Unlinking them one by one with Release
+// would have to start from the head for every object.
+//
+//==========================================================================
+
+void ReleaseScoped(unsigned mark)
+{
+	unsigned pending = 0;
+	for (unsigned i = mark; i < ScopedObjects.Size(); i++)
+	{
+		DObject *obj = ScopedObjects[i];
+		if (obj == nullptr)
+		{
+			continue;
+		}
+		if (!(obj->ObjectFlags & OF_EuthanizeMe))
+		{
+			obj->Destroy();
+		}
+		obj->ObjectFlags |= OF_Cleanup;
+		pending++;
+	}
+
+	for (DObject **probe = &Root; pending > 0 && *probe != nullptr; )
+	{
+		DObject *curr = *probe;
+		if (!(curr->ObjectFlags & OF_Cleanup))
+		{
+			probe = &curr->ObjNext;
+			continue;
+		}
+		*probe = curr->ObjNext;
+		if (&curr->ObjNext == SweepPos)
+		{
+			SweepPos = probe;
+		}
+		if (curr->IsGray())
+		{
+			for (DObject **gprobe = &Gray; *gprobe != nullptr; gprobe = &(*gprobe)->GCNext)
+			{
+				if (*gprobe == curr)
+				{
+					*gprobe = curr->GCNext;
+					break;
+				}
+			}
+		}
+		curr->ObjNext = nullptr;
+		curr->GCNext = nullptr;
+		curr->ObjectFlags |= OF_Released;
+		pending--;
+	}
+
+	while (ScopedObjects.Size() > mark)
+	{
+		DObject *obj;
+		ScopedObjects.Pop(obj);
+		if (obj == nullptr)
+		{
+			continue;
+		}
+		if (!(obj->ObjectFlags & OF_Released))
+		{
+			// Not on the object list, so it is not ours to free.
+			obj->ObjectFlags &= ~OF_Cleanup;
+			continue;
+		}
+		delete obj;
+		ScopedReleased++;
+	}
+}
+
 }
 
 //==========================================================================
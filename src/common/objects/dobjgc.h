@@ -146,6 +146,16 @@ namespace GC
 	// Unroots an object.
 	void DelSoftRoot(DObject *obj);
 
+	// Objects created by 'new' expressions that the script compiler proved
+	// cannot outlive the function creating them.
+	extern TArray<DObject *> ScopedObjects;
+
+	// Number of scoped objects freed without going through a collection.
+	extern size_t ScopedReleased;
+
+	// Destroys and frees the scoped objects created since mark was taken.
+	void ReleaseScoped(unsigned mark);
+
 	template<class T> void Mark(T *&obj)
 	{
 		union
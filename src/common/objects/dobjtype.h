@@ -77,6 +77,7 @@ public:
 	bool				 bSealed = false;
 	bool				 bFinal = false;
 	bool				 bOptional = false;
+	int					 LiveThinkers = 0;		// linked thinkers of this class or a subclass, lets thinker iterators skip absent classes
 	TArray<VMFunction*>	 Virtuals;	// virtual function table
 	TArray<FTypeAndOffset> MetaInits;
 	TArray<FTypeAndOffset> SpecialInits;
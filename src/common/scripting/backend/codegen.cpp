@@ -44,13 +44,46 @@
 #include "m_random.h"
 #include "v_font.h"
 #include "palettecontainer.h"
+#include "c_cvars.h"
+#include "c_dispatch.h"
+#include "printf.h"
 
+CVAR(Bool, vm_inline, true, CVAR_GLOBALCONFIG | CVAR_ARCHIVE)
+CVAR(Bool, vm_scopednew, false, CVAR_GLOBALCONFIG | CVAR_ARCHIVE)
 
 extern FRandom pr_exrandom;
 FMemArena FxAlloc(65536);
 CompileEnvironment compileEnvironment;
 FTranslationID R_FindCustomTranslation(FName name);
 
+static struct
+{
+	int Inlined;
+	int Devirtualized;
+	TArray<FString> Sites;
+} InlineStats;
+
+struct FScopeCandidate
+{
+	FxLocalVariableDeclaration *Variable;
+	FxNew *New;
+};
+
+static struct
+{
+	// These only cover the function currently being compiled.
+	TArray<FScopeCandidate> Candidates;
+	int SelfReferences;
+	int SafeSelfReferences;
+	int Generation;
+	PFunction *Function;
+
+	TMap<PFunction *, bool> LocalSelf;	// methods that never let self escape
+	TArray<FString> Sites;
+} ScopeAnalysis;
+
+static void MarkScopeSafe(FxExpression *x);
+
 struct FLOP
 {
 	ENamedName Name;
@@ -5793,6 +5826,30 @@ FxExpression *FxNew::Resolve(FCompileContext &ctx)
 	return this;
 }
 
+//==========================================================================
+//
+// FxNew :: ScopeCandidateClass
+//
+// Returns the class if this creates a plain script object, which is the
+// only kind that may be freed as soon as the creating function returns.
+// Native classes can register the object somewhere in their constructor,
+// and an OnDestroy override could do the same when it gets released.
+//
+//==========================================================================
+
+PClass *FxNew::ScopeCandidateClass() const
+{
+	if (!val->isConstant()) return nullptr;
+	auto cls = static_cast<PClass *>(static_cast<FxConstant*>(val)->GetValue().GetPointer());
+	if (cls == nullptr || cls->bAbstract || cls->NativeClass() != RUNTIME_CLASS(DObject)) return nullptr;
+
+	static unsigned VIndex = ~0u;
+	if (VIndex == ~0u) VIndex = GetVirtualIndex(RUNTIME_CLASS(DObject), "OnDestroy");
+	auto &basevirtuals = RUNTIME_CLASS(DObject)->Virtuals;
+	if (VIndex >= cls->Virtuals.Size() || VIndex >= basevirtuals.Size() || cls->Virtuals[VIndex] != basevirtuals[VIndex]) return nullptr;
+	return cls;
+}
+
 //==========================================================================
 //
 //
@@ -5831,13 +5888,53 @@ DEFINE_ACTION_FUNCTION_NATIVE(DObject, BuiltinNew, BuiltinNew)
 	ACTION_RETURN_OBJECT(BuiltinNew(cls, outerside, compatible));
 }
 
+static DObject *BuiltinNewScoped(PClass *cls, int outerside, int backwardscompatible)
+{
+	DObject *object = BuiltinNew(cls, outerside, backwardscompatible);
+	GC::ScopedObjects.Push(object);
+	return object;
+}
+
+DEFINE_ACTION_FUNCTION_NATIVE(DObject, BuiltinNewScoped, BuiltinNewScoped)
+{
+	PARAM_PROLOGUE;
+	PARAM_CLASS(cls, DObject);
+	PARAM_INT(outerside);
+	PARAM_INT(compatible);
+	ACTION_RETURN_OBJECT(BuiltinNewScoped(cls, outerside, compatible));
+}
+
+static int BuiltinScopeMark()
+{
+	return GC::ScopedObjects.Size();
+}
+
+DEFINE_ACTION_FUNCTION_NATIVE(DObject, BuiltinScopeMark, BuiltinScopeMark)
+{
+	PARAM_PROLOGUE;
+	ACTION_RETURN_INT(BuiltinScopeMark());
+}
+
+static void BuiltinScopeRelease(int mark)
+{
+	GC::ReleaseScoped(mark);
+}
+
+DEFINE_ACTION_FUNCTION_NATIVE(DObject, BuiltinScopeRelease, BuiltinScopeRelease)
+{
+	PARAM_PROLOGUE;
+	PARAM_INT(mark);
+	BuiltinScopeRelease(mark);
+	return 0;
+}
+
 ExpEmit FxNew::Emit(VMFunctionBuilder *build)
 {
 	ExpEmit to(build, REGT_POINTER);
 
 	// Call DecoRandom to generate a random number.
 	VMFunction *callfunc;
-	auto sym = FindBuiltinFunction(compileEnvironment.CustomBuiltinNew != NAME_None? compileEnvironment.CustomBuiltinNew : NAME_BuiltinNew);
+	auto sym = FindBuiltinFunction(Scoped ? NAME_BuiltinNewScoped : compileEnvironment.CustomBuiltinNew != NAME_None? compileEnvironment.CustomBuiltinNew : NAME_BuiltinNew);
 
 	assert(sym);
 	callfunc = sym->Variants[0].Implementation;
@@ -7115,6 +7212,16 @@ FxLocalVariable::FxLocalVariable(FxLocalVariableDeclaration *var, const FScriptP
 	ValueType = var->ValueType;
 	AddressRequested = false;
 	RegOffset = 0;
+	var->References++;
+}
+
+void FxLocalVariable::MarkScopeSafe()
+{
+	if (!ScopeSafe)
+	{
+		ScopeSafe = true;
+		Variable->SafeReferences++;
+	}
 }
 
 FxExpression *FxLocalVariable::Resolve(FCompileContext &ctx)
@@ -7202,6 +7309,29 @@ FxSelf::FxSelf(const FScriptPosition &pos, bool deccheck)
 : FxExpression(EFX_Self, pos)
 {
 	check = deccheck;
+	ScopeGeneration = -1;
+	CountScopeReference();
+}
+
+// Some self nodes get created before the function they belong to starts being compiled,
+// so the count gets repeated for those once they are seen again while resolving.
+void FxSelf::CountScopeReference()
+{
+	if (ScopeGeneration != ScopeAnalysis.Generation)
+	{
+		ScopeGeneration = ScopeAnalysis.Generation;
+		ScopeAnalysis.SelfReferences++;
+	}
+}
+
+void FxSelf::MarkScopeSafe()
+{
+	CountScopeReference();
+	if (!ScopeSafe)
+	{
+		ScopeSafe = true;
+		ScopeAnalysis.SafeSelfReferences++;
+	}
 }
 
 //==========================================================================
@@ -7220,6 +7350,7 @@ FxExpression *FxSelf::Resolve(FCompileContext& ctx)
 		return nullptr;
 	}
 	ValueType = NewPointer(ctx.Function->Variants[0].SelfClass);
+	CountScopeReference();
 	return this;
 }  
 
@@ -7231,6 +7362,11 @@ FxExpression *FxSelf::Resolve(FCompileContext& ctx)
 
 ExpEmit FxSelf::Emit(VMFunctionBuilder *build)
 {
+	// A self reference the analysis never saw may let self escape, so the function cannot be trusted to keep it.
+	if (ScopeGeneration != ScopeAnalysis.Generation && ScopeAnalysis.Function != nullptr)
+	{
+		ScopeAnalysis.LocalSelf.Remove(ScopeAnalysis.Function);
+	}
 	if (check)
 	{
 		build->Emit(OP_EQA_R, 1, 0, 1);
@@ -7258,6 +7394,7 @@ FxExpression *FxSuper::Resolve(FCompileContext& ctx)
 		return nullptr;
 	}
 	ValueType = TypeError;	// this intentionally resolves to an invalid type so that it cannot be used outside of super calls.
+	CountScopeReference();
 	return this;
 }
 
@@ -7657,6 +7794,10 @@ FxExpression *FxStructMember::Resolve(FCompileContext &ctx)
 			delete this;
 			return nullptr;
 		}
+		// Reading or writing a plain member does not let the object itself escape.
+		// Everything else, like structs, arrays and maps, evaluates to an address inside the object, so it does not count.
+		auto mtype = membervar->Type;
+		if (mtype->isScalar() || mtype->isPointer() || mtype == TypeString || mtype == TypeName) MarkScopeSafe(classx);
 	}
 	else if (classx->ValueType->isStruct())
 	{
@@ -9872,6 +10013,11 @@ FxExpression *FxVMFunctionCall::Resolve(FCompileContext& ctx)
 		ValueType = TypeVoid;
 	}
 
+	// Calling a method that keeps self to itself does not let the object escape either.
+	if (Self != nullptr && !FnPtrCall && (NoVirtual || !(Function->Variants[0].Flags & VARF_Virtual)) && ScopeAnalysis.LocalSelf.CheckKey(Function) != nullptr)
+	{
+		MarkScopeSafe(Self);
+	}
 	return this;
 }
 
@@ -9900,6 +10046,18 @@ ExpEmit FxVMFunctionCall::Emit(VMFunctionBuilder *build)
 	VMFunction *vmfunc = FnPtrCall ? nullptr : Function->Variants[0].Implementation;
 	bool staticcall = (FnPtrCall || (vmfunc->VarFlags & VARF_Final) || vmfunc->VirtualIndex == ~0u || NoVirtual);
 
+	// A virtual call on a final class can only ever reach the implementation that was found at compile time.
+	bool devirtualized = false;
+	if (!staticcall && Self != nullptr && Self->ValueType->isObjectPointer())
+	{
+		auto cls = static_cast<PObjectPointer*>(Self->ValueType)->PointedClass();
+		if (cls != nullptr && cls->bFinal)
+		{
+			staticcall = devirtualized = true;
+			InlineStats.Devirtualized++;
+		}
+	}
+
 	count = 0;
 
 	assert(!FnPtrCall || (FnPtrCall && Self && Self->ValueType && Self->ValueType->isFunctionPointer()));
@@ -9931,6 +10089,20 @@ ExpEmit FxVMFunctionCall::Emit(VMFunctionBuilder *build)
 			}
 		}
 
+		if (devirtualized)
+		{
+			// The VTBL lookup would have caught a null self, so keep doing that.
+			build->Emit(OP_NULLCHECK, selfemit.RegNum, 0, 0);
+		}
+
+		ExpEmit inlined;
+		if (staticcall && vm_inline && EmitInline(build, selfemit, inlined))
+		{
+			ArgList.DeleteAndClear();
+			ArgList.ShrinkToFit();
+			return inlined;
+		}
+
 		emitters.AddParameter(selfemit, (selfemit.Fixed && selfemit.Target) || selfemit.RegType == REGT_STRING);
 		if (Function->Variants[0].Flags & VARF_Action)
 		{
@@ -10045,6 +10217,217 @@ bool FxVMFunctionCall::CheckEmitCast(VMFunctionBuilder *build, bool returnit, Ex
 	return false;
 }
 
+//==========================================================================
+//
+// Replaces a static call to a trivial method with the method's body.
+// Only bodies that consist of nothing but returning a constant or a
+// member of self qualify, e.g. simple accessors. Their code does not
+// depend on anything but self, so it can be reproduced in the caller
+// with the callee's constants moved over. The callee must already have
+// been compiled, which is always the case for the engine's base classes.
+//
+//==========================================================================
+
+bool FxVMFunctionCall::EmitInline(VMFunctionBuilder *build, ExpEmit &selfemit, ExpEmit &result)
+{
+	if (FnPtrCall || AssignCount > 1 || ArgList.Size() > 0) return false;
+	if (selfemit.RegType != REGT_POINTER || selfemit.Konst || (selfemit.Fixed && selfemit.Target)) return false;
+
+	VMFunction *vmfunc = Function->Variants[0].Implementation;
+	if (vmfunc == nullptr || (vmfunc->VarFlags & (VARF_Native | VARF_Abstract))) return false;
+	auto proto = vmfunc->Proto;
+	if (proto == nullptr || proto->ReturnTypes.Size() != 1 || proto->ArgumentTypes.Size() != Function->GetImplicitArgs()) return false;
+
+	auto func = static_cast<VMScriptFunction *>(vmfunc);
+	if (func->Code == nullptr || func->ExtraSpace > 0 || func->SpecialInits.Size() > 0) return false;
+
+	const VMOP *code = func->Code;
+	const VMOP &ret = code[func->CodeSize - 1];
+	int rettype = proto->ReturnTypes[0]->GetRegType();
+
+	if (func->CodeSize == 1 && ret.op == OP_RETI && ret.a == RET_FINAL && rettype == REGT_INT)
+	{
+		result = ExpEmit(build->GetConstantInt(ret.i16), REGT_INT, true);
+	}
+	else if (func->CodeSize == 1 && ret.op == OP_RET && ret.a == RET_FINAL && ret.b == (rettype | REGT_KONST))
+	{
+		switch (rettype)
+		{
+		case REGT_INT:		result = ExpEmit(build->GetConstantInt(func->KonstD[ret.c]), REGT_INT, true); break;
+		case REGT_FLOAT:	result = ExpEmit(build->GetConstantFloat(func->KonstF[ret.c]), REGT_FLOAT, true); break;
+		case REGT_STRING:	result = ExpEmit(build->GetConstantString(func->KonstS[ret.c]), REGT_STRING, true); break;
+		case REGT_POINTER:	result = ExpEmit(build->GetConstantAddress(func->KonstA[ret.c].v), REGT_POINTER, true); break;
+		default:			return false;
+		}
+	}
+	else if (func->CodeSize == 2 && ret.op == OP_RET && ret.a == RET_FINAL && ret.c == code[0].a && code[0].b == 0)
+	{
+		// rA = *(self + KonstD[C])
+		const VMOP &load = code[0];
+		switch (load.op)
+		{
+		case OP_LB: case OP_LH: case OP_LW: case OP_LBU: case OP_LHU:
+		case OP_LSP: case OP_LDP: case OP_LS: case OP_LO: case OP_LP:
+		case OP_LV2: case OP_LV3: case OP_LV4: case OP_LFV2: case OP_LFV3: case OP_LFV4:
+			break;
+		default:
+			return false;
+		}
+		int regcount = (ret.b & REGT_MULTIREG2) ? 2 : (ret.b & REGT_MULTIREG3) ? 3 : (ret.b & REGT_MULTIREG4) ? 4 : 1;
+		if ((ret.b & ~REGT_MULTIREG) != rettype || regcount != proto->ReturnTypes[0]->GetRegCount()) return false;
+
+		result = ExpEmit(build, rettype, regcount);
+		build->Emit(load.op, result.RegNum, selfemit.RegNum, build->GetConstantInt(func->KonstD[load.c]));
+	}
+	else if (func->CodeSize == 3 && code[0].op == OP_ADDA_RK && code[0].b == 0 && code[1].op == OP_LBIT && code[1].b == code[0].a &&
+		ret.op == OP_RET && ret.a == RET_FINAL && ret.b == REGT_INT && ret.c == code[1].a && rettype == REGT_INT)
+	{
+		// Boolean flag member: rA = !!(*(self + KonstD[C]) & mask)
+		ExpEmit addr(build, REGT_POINTER);
+		build->Emit(OP_ADDA_RK, addr.RegNum, selfemit.RegNum, build->GetConstantInt(func->KonstD[code[0].c]));
+		result = ExpEmit(build, REGT_INT);
+		build->Emit(OP_LBIT, result.RegNum, addr.RegNum, code[1].c);
+		addr.Free(build);
+	}
+	else
+	{
+		return false;
+	}
+	selfemit.Free(build);
+
+	InlineStats.Inlined++;
+	InlineStats.Sites.Push(FStringf("%s:%d: %s in %s", ScriptPosition.FileName.GetChars(), ScriptPosition.ScriptLine,
+		func->PrintableName, CallingFunction != nullptr ? CallingFunction->Variants[0].Implementation->PrintableName : "<unknown>"));
+	return true;
+}
+
+//==========================================================================
+//
+// CCMD dumpinlinedcalls
+//
+// Lists the call sites that were replaced by the callee's body, optionally
+// filtered by a substring of the callee's or the caller's name.
+//
+//==========================================================================
+
+CCMD(dumpinlinedcalls)
+{
+	const char *filter = argv.argc() > 1 ? argv[1] : nullptr;
+	int shown = 0;
+	for (auto &site : InlineStats.Sites)
+	{
+		if (filter == nullptr || site.IndexOf(filter) >= 0)
+		{
+			Printf("%s\n", site.GetChars());
+			shown++;
+		}
+	}
+	Printf("%d of %d inlined call sites shown, %d virtual calls devirtualized\n", shown, InlineStats.Inlined, InlineStats.Devirtualized);
+}
+
+//==========================================================================
+//
+// Scoped allocation
+//
+// A 'new' that initializes a local variable which is only ever used to
+// access members of the object, or as self of a method that does not let
+// self escape either, cannot produce an object that outlives the function.
+// Such objects get freed when the function returns instead of being left
+// to the collector. Every reference node counts itself when it gets
+// created or resolved and the nodes in one of the safe positions above
+// mark themselves, so anything the analysis does not know about keeps the
+// object on the heap.
+//
+//==========================================================================
+
+static void MarkScopeSafe(FxExpression *x)
+{
+	if (x->ExprType == EFX_LocalVariable) static_cast<FxLocalVariable *>(x)->MarkScopeSafe();
+	else if (x->ExprType == EFX_Self) static_cast<FxSelf *>(x)->MarkScopeSafe();
+}
+
+void BeginScriptCompile()
+{
+	// Functions from a previous compile may have been freed, and their addresses reused.
+	ScopeAnalysis.LocalSelf.Clear();
+	ScopeAnalysis.Sites.Clear();
+	InlineStats.Inlined = 0;
+	InlineStats.Devirtualized = 0;
+	InlineStats.Sites.Clear();
+}
+
+void BeginScopeAnalysis()
+{
+	ScopeAnalysis.Candidates.Clear();
+	ScopeAnalysis.Function = nullptr;
+	ScopeAnalysis.Generation++;
+	ScopeAnalysis.SelfReferences = 0;
+	ScopeAnalysis.SafeSelfReferences = 0;
+}
+
+int FinishScopeAnalysis(PFunction *func, VMFunctionBuilder *build)
+{
+	int promoted = 0;
+
+	if (ScopeAnalysis.SelfReferences == ScopeAnalysis.SafeSelfReferences)
+	{
+		ScopeAnalysis.LocalSelf[func] = true;
+	}
+	if (vm_scopednew && compileEnvironment.CustomBuiltinNew == NAME_None)
+	{
+		for (auto &cand : ScopeAnalysis.Candidates)
+		{
+			if (cand.Variable->References == cand.Variable->SafeReferences)
+			{
+				auto cls = cand.New->ScopeCandidateClass();
+				cand.New->Scoped = true;
+				ScopeAnalysis.Sites.Push(FStringf("%s:%d: %s in %s", cand.New->ScriptPosition.FileName.GetChars(), cand.New->ScriptPosition.ScriptLine,
+					cls->TypeName.GetChars(), func->Variants[0].Implementation->PrintableName));
+				promoted++;
+			}
+		}
+	}
+	if (promoted > 0)
+	{
+		// Remember how far the scoped stack went on entry so that every return can release what this call added.
+		auto sym = FindBuiltinFunction(NAME_BuiltinScopeMark);
+		assert(sym);
+		FunctionCallEmitter emitters(sym->Variants[0].Implementation);
+		emitters.AddReturn(REGT_INT);
+		build->ScopeMark = emitters.EmitCall(build);
+		build->ScopeMark.Fixed = true;
+	}
+	// Keep the generation so that emitting the function can still spot self references that were never counted.
+	ScopeAnalysis.Candidates.Clear();
+	ScopeAnalysis.Function = func;
+	return promoted;
+}
+
+//==========================================================================
+//
+// CCMD dumpscopedallocations
+//
+// Lists the 'new' expressions whose objects are freed when the creating
+// function returns, optionally filtered by a substring of the class or
+// the function name.
+//
+//==========================================================================
+
+CCMD(dumpscopedallocations)
+{
+	const char *filter = argv.argc() > 1 ? argv[1] : nullptr;
+	int shown = 0;
+	for (auto &site : ScopeAnalysis.Sites)
+	{
+		if (filter == nullptr || site.IndexOf(filter) >= 0)
+		{
+			Printf("%s\n", site.GetChars());
+			shown++;
+		}
+	}
+	Printf("%d of %u scoped allocation sites shown, %zu objects released on return\n", shown, ScopeAnalysis.Sites.Size(), GC::ScopedReleased);
+}
+
 //==========================================================================
 //
 //
@@ -11978,8 +12361,8 @@ ExpEmit FxReturnStatement::Emit(VMFunctionBuilder *build)
 
 	ExpEmit out(0, REGT_NIL);
 
-	// If there's structs to destroy here we need to emit all returns before destroying them.
-	if (build->ConstructedStructs.Size())
+	// If there's structs to destroy or scoped objects to release here we need to emit all returns before doing so.
+	if (build->ConstructedStructs.Size() || build->ScopeMark.RegType != REGT_NIL)
 	{
 		for (auto ret : Args)
 		{
@@ -12001,6 +12384,16 @@ ExpEmit FxReturnStatement::Emit(VMFunctionBuilder *build)
 		emitters.EmitCall(build);
 	}
 
+	// release the objects this function created that cannot outlive it.
+	if (build->ScopeMark.RegType != REGT_NIL)
+	{
+		auto sym = FindBuiltinFunction(NAME_BuiltinScopeRelease);
+		assert(sym);
+		FunctionCallEmitter emitters(sym->Variants[0].Implementation);
+		emitters.AddParameter(build->ScopeMark, false);
+		emitters.EmitCall(build);
+	}
+
 	// If we return nothing, use a regular RET opcode.
 	// Otherwise just return the value we're given.
 	if (Args.Size() == 0)
@@ -12569,6 +12962,14 @@ FxLocalVariableDeclaration::FxLocalVariableDeclaration(PType *type, FName name,
 
 FxLocalVariableDeclaration::~FxLocalVariableDeclaration()
 {
+	for (unsigned i = 0; i < ScopeAnalysis.Candidates.Size(); i++)
+	{
+		if (ScopeAnalysis.Candidates[i].Variable == this)
+		{
+			ScopeAnalysis.Candidates.Delete(i);
+			break;
+		}
+	}
 	SAFE_DELETE(Init);
 }
 
@@ -12667,6 +13068,10 @@ FxExpression *FxLocalVariableDeclaration::Resolve(FCompileContext &ctx)
 		SAFE_RESOLVE(clearExpr, ctx);
 	}
 
+	if (Init != nullptr && Init->ExprType == EFX_New && static_cast<FxNew *>(Init)->ScopeCandidateClass() != nullptr)
+	{
+		ScopeAnalysis.Candidates.Push({ this, static_cast<FxNew *>(Init) });
+	}
 	ctx.Block->LocalVars.Push(this);
 	return this;
 }
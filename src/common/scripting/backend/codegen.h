@@ -1302,10 +1302,12 @@ class FxNew : public FxExpression
 	PFunction *CallingFunction;
 
 public:
+	bool Scoped = false;	// the object cannot outlive the calling function
 
 	FxNew(FxExpression *v);
 	~FxNew();
 	FxExpression *Resolve(FCompileContext&);
+	PClass *ScopeCandidateClass() const;
 
 	ExpEmit Emit(VMFunctionBuilder *build);
 };
@@ -1508,9 +1510,11 @@ class FxLocalVariable : public FxExpression
 public:
 	FxLocalVariableDeclaration *Variable;
 	bool AddressRequested;
+	bool ScopeSafe = false;
 	int RegOffset;
 
 	FxLocalVariable(FxLocalVariableDeclaration*, const FScriptPosition&);
+	void MarkScopeSafe();
 	FxExpression *Resolve(FCompileContext&);
 	bool RequestAddress(FCompileContext &ctx, bool *writable);
 	ExpEmit Emit(VMFunctionBuilder *build);
@@ -1561,9 +1565,15 @@ public:
 class FxSelf : public FxExpression
 {
 	bool check;
+	bool ScopeSafe = false;
+	int ScopeGeneration;
+
+protected:
+	void CountScopeReference();
 
 public:
 	FxSelf(const FScriptPosition&, bool deccheck = false);
+	void MarkScopeSafe();
 	FxExpression *Resolve(FCompileContext&);
 	ExpEmit Emit(VMFunctionBuilder *build);
 };
@@ -1868,6 +1878,7 @@ public:
 	VMFunction *GetDirectFunction(PFunction *func, const VersionInfo &ver);
 	ExpEmit Emit(VMFunctionBuilder *build);
 	bool CheckEmitCast(VMFunctionBuilder *build, bool returnit, ExpEmit &reg);
+	bool EmitInline(VMFunctionBuilder *build, ExpEmit &selfemit, ExpEmit &result);
 	TArray<PType*> &GetReturnTypes() const
 	{
 		return Function->Variants[0].Proto->ReturnTypes;
@@ -2292,6 +2303,8 @@ protected:
 public:
 	int StackOffset = -1;
 	int RegNum = -1;
+	int References = 0;		// FxLocalVariable nodes created for this variable
+	int SafeReferences = 0;	// ... and how many of them cannot let an object escape
 
 	FxLocalVariableDeclaration(PType *type, FName name, FxExpression *initval, int varflags, const FScriptPosition &p);
 	~FxLocalVariableDeclaration();
@@ -2399,4 +2412,8 @@ struct CompileEnvironment
 
 extern CompileEnvironment compileEnvironment;
 
+void BeginScriptCompile();
+void BeginScopeAnalysis();
+int FinishScopeAnalysis(PFunction *func, VMFunctionBuilder *build);
+
 #endif
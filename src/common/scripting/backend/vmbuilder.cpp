@@ -38,8 +38,12 @@
 #include "c_cvars.h"
 #include "jit.h"
 #include "filesystem.h"
+#include "c_dispatch.h"
+#include "printf.h"
+#include "stats.h"
 
 CVAR(Bool, strictdecorate, false, CVAR_GLOBALCONFIG | CVAR_ARCHIVE)
+CVAR(Bool, vm_optimize, false, CVAR_GLOBALCONFIG | CVAR_ARCHIVE)
 
 EXTERN_CVAR(Bool, vm_jit)
 EXTERN_CVAR(Bool, vm_jit_aot)
@@ -774,6 +778,466 @@ void VMFunctionBuilder::BackpatchListToHere(TArray<size_t> &locs)
 		Backpatch(loc, Code.Size());
 }
 
+//==========================================================================
+//
+// Bytecode optimizer helpers
+//
+// The optimizer only looks into instructions listed here. Everything else
+// is treated as an opaque operation that may read or write any register.
+//
+//==========================================================================
+
+static struct FOptimizerStats
+{
+	int Functions, Instructions, Removed, Folded, Threaded, Rejected;
+} OptStats;
+
+enum
+{
+	KNOWN_NONE,
+	KNOWN_CONST,
+	KNOWN_COPY,
+};
+
+struct FKnownValue
+{
+	uint8_t Kind;
+	uint8_t Reg;		// for KNOWN_COPY
+	uint64_t Bits;		// for KNOWN_CONST
+};
+
+// Returns the register type written by a side effect free instruction, or
+// REGT_NIL if the instruction is not one the optimizer understands.
+static int PureDefType(int op)
+{
+	switch (op)
+	{
+	case OP_LI: case OP_LK: case OP_MOVE:
+	case OP_ADD_RR: case OP_ADD_RK: case OP_ADDI:
+	case OP_SUB_RR: case OP_SUB_RK: case OP_SUB_KR:
+	case OP_MUL_RR: case OP_MUL_RK:
+	case OP_AND_RR: case OP_AND_RK: case OP_OR_RR: case OP_OR_RK: case OP_XOR_RR: case OP_XOR_RK:
+		return REGT_INT;
+
+	case OP_LKF: case OP_MOVEF:
+	case OP_ADDF_RR: case OP_ADDF_RK: case OP_SUBF_RR: case OP_SUBF_RK: case OP_MULF_RR: case OP_MULF_RK:
+		return REGT_FLOAT;
+
+	case OP_LKP: case OP_MOVEA:
+		return REGT_POINTER;
+
+	default:
+		return REGT_NIL;
+	}
+}
+
+// Checks whether a side effect free instruction reads the given register.
+static bool PureReads(const VMOP &op, int regtype, int reg)
+{
+	switch (op.op)
+	{
+	case OP_LI: case OP_LK: case OP_LKF: case OP_LKP:
+		return false;
+
+	case OP_MOVE: case OP_ADD_RK: case OP_ADDI: case OP_SUB_RK: case OP_MUL_RK: case OP_AND_RK: case OP_OR_RK: case OP_XOR_RK:
+		return regtype == REGT_INT && op.b == reg;
+
+	case OP_SUB_KR:
+		return regtype == REGT_INT && op.c == reg;
+
+	case OP_ADD_RR: case OP_SUB_RR: case OP_MUL_RR: case OP_AND_RR: case OP_OR_RR: case OP_XOR_RR:
+		return regtype == REGT_INT && (op.b == reg || op.c == reg);
+
+	case OP_MOVEF: case OP_ADDF_RK: case OP_SUBF_RK: case OP_MULF_RK:
+		return regtype == REGT_FLOAT && op.b == reg;
+
+	case OP_ADDF_RR: case OP_SUBF_RR: case OP_MULF_RR:
+		return regtype == REGT_FLOAT && (op.b == reg || op.c == reg);
+
+	case OP_MOVEA:
+		return regtype == REGT_POINTER && op.b == reg;
+
+	default:
+		return true;
+	}
+}
+
+// Instructions that never skip or consume the instruction after them, so
+// that one may be removed. Comparisons, TEST and the jump tables of IJMP
+// depend on what directly follows them.
+static bool KeepsSuccessor(int op)
+{
+	return PureDefType(op) != REGT_NIL || op == OP_PARAM || op == OP_PARAMI || op == OP_CALL || op == OP_CALL_K || op == OP_RESULT ||
+		(op >= OP_LB && op <= OP_LBIT) || (op >= OP_SB && op <= OP_SBIT);
+}
+
+//==========================================================================
+//
+// VMFunctionBuilder :: Optimize
+//
+// Cleans up the emitted code before MakeFunction copies it: jumps to jumps
+// are threaded, moves and constant loads of values a register already
+// holds are dropped, integer arithmetic on known constants is folded and
+// pure instructions whose result is overwritten before being read are
+// removed. Register contents are only tracked through straight-line code
+// and are forgotten at jump targets and at any instruction the optimizer
+// does not understand.
+//
+// The result is checked against the original before it is accepted. If
+// the check fails the original code is kept. Returns true if the code was
+// changed.
+//
+//==========================================================================
+
+bool VMFunctionBuilder::Optimize()
+{
+	const int count = Code.Size();
+	if (count == 0) return false;
+
+	auto jumpTarget = [&](int i) { return i + 1 + Code[i].i24; };
+
+	TArray<VMOP> original = Code;
+	TArray<bool> dead, leader;
+	dead.Resize(count);
+	leader.Resize(count + 1);
+	for (int i = 0; i < count; i++) dead[i] = false;
+	for (int i = 0; i <= count; i++) leader[i] = false;
+	leader[0] = true;
+
+	// Leave code with jumps out of the function alone, before anything gets rewritten.
+	for (int i = 0; i < count; i++)
+	{
+		if (Code[i].op == OP_JMP && (jumpTarget(i) < 0 || jumpTarget(i) > count)) return false;
+	}
+
+	OptStats.Functions++;
+	OptStats.Instructions += count;
+
+	// Thread jumps to jumps and find the start of every basic block. An
+	// instruction that may be skipped ends a block as well.
+	for (int i = 0; i < count; i++)
+	{
+		if (!KeepsSuccessor(Code[i].op) && i + 2 <= count) leader[i + 2] = true;
+		if (Code[i].op != OP_JMP) continue;
+		int target = jumpTarget(i);
+		for (int hops = 0; hops < 8 && target != i && target >= 0 && target < count && Code[target].op == OP_JMP; hops++)
+		{
+			target = jumpTarget(target);
+		}
+		if (target != jumpTarget(i))
+		{
+			Code[i].i24 = target - i - 1;
+			OptStats.Threaded++;
+		}
+		leader[target] = true;
+	}
+
+	// Forward pass over each block, tracking known register contents.
+	FKnownValue known[4][256];
+	bool listed[4][256];
+	TArray<uint16_t> touched;
+
+	auto forgetAll = [&]()
+	{
+		for (auto t : touched) known[t >> 8][t & 255].Kind = KNOWN_NONE, listed[t >> 8][t & 255] = false;
+		touched.Clear();
+	};
+	auto forget = [&](int type, int reg)
+	{
+		known[type][reg].Kind = KNOWN_NONE;
+		for (auto t : touched)
+		{
+			auto &k = known[t >> 8][t & 255];
+			if ((t >> 8) == type && k.Kind == KNOWN_COPY && k.Reg == reg) k.Kind = KNOWN_NONE;
+		}
+	};
+	auto set = [&](int type, int reg, int kind, int copyreg, uint64_t bits)
+	{
+		forget(type, reg);
+		known[type][reg] = { (uint8_t)kind, (uint8_t)copyreg, bits };
+		if (!listed[type][reg])
+		{
+			listed[type][reg] = true;
+			touched.Push(uint16_t((type << 8) | reg));
+		}
+	};
+	auto same = [&](int type, int a, int b)
+	{
+		auto &ka = known[type][a], &kb = known[type][b];
+		if (ka.Kind == KNOWN_COPY && ka.Reg == b) return true;
+		if (kb.Kind == KNOWN_COPY && kb.Reg == a) return true;
+		if (ka.Kind == KNOWN_COPY && kb.Kind == KNOWN_COPY && ka.Reg == kb.Reg) return true;
+		return ka.Kind == KNOWN_CONST && kb.Kind == KNOWN_CONST && ka.Bits == kb.Bits;
+	};
+	auto setConst = [&](int type, int reg, uint64_t bits, int at, bool removable)
+	{
+		auto &k = known[type][reg];
+		if (removable && k.Kind == KNOWN_CONST && k.Bits == bits)
+		{
+			dead[at] = true;
+		}
+		else
+		{
+			set(type, reg, KNOWN_CONST, 0, bits);
+		}
+	};
+	auto intValue = [&](int reg, int *val)
+	{
+		auto &k = known[REGT_INT][reg];
+		if (k.Kind != KNOWN_CONST) return false;
+		*val = (int)(uint32_t)k.Bits;
+		return true;
+	};
+
+	memset(known, 0, sizeof(known));
+	memset(listed, 0, sizeof(listed));
+
+	for (int i = 0; i < count; i++)
+	{
+		if (leader[i]) forgetAll();
+		// Only remove an instruction if its predecessor cannot skip it.
+		bool removable = i == 0 || KeepsSuccessor(Code[i - 1].op);
+		auto &op = Code[i];
+		int b, c, result;
+		uint64_t bits;
+
+		switch (op.op)
+		{
+		case OP_LI:
+			setConst(REGT_INT, op.a, (uint32_t)op.i16, i, removable);
+			break;
+
+		case OP_LK:
+			setConst(REGT_INT, op.a, (uint32_t)IntConstantList[op.i16u], i, removable);
+			break;
+
+		case OP_LKF:
+			memcpy(&bits, &FloatConstantList[op.i16u], sizeof(bits));
+			setConst(REGT_FLOAT, op.a, bits, i, removable);
+			break;
+
+		case OP_LKP:
+			setConst(REGT_POINTER, op.a, (uint64_t)(uintptr_t)AddressConstantList[op.i16u], i, removable);
+			break;
+
+		case OP_MOVE:
+		case OP_MOVEF:
+		case OP_MOVEA:
+		{
+			int type = PureDefType(op.op);
+			if (removable && (op.a == op.b || same(type, op.a, op.b)))
+			{
+				dead[i] = true;
+			}
+			else if (op.a != op.b)
+			{
+				auto kb = known[type][op.b];
+				if (kb.Kind == KNOWN_CONST) set(type, op.a, KNOWN_CONST, 0, kb.Bits);
+				else set(type, op.a, KNOWN_COPY, kb.Kind == KNOWN_COPY ? kb.Reg : op.b, 0);
+			}
+			break;
+		}
+
+		case OP_MOVES:
+			if (removable && op.a == op.b) dead[i] = true;
+			else forgetAll();
+			break;
+
+		case OP_PARAM:
+		case OP_PARAMI:
+			break;
+
+		default:
+			if (PureDefType(op.op) == REGT_INT)
+			{
+				// Fold integer arithmetic on known constants.
+				bool folded = false;
+				switch (op.op)
+				{
+				case OP_ADDI:
+					if (intValue(op.b, &b)) result = int(uint32_t(b) + uint32_t(op.cs)), folded = true;
+					break;
+				case OP_SUB_KR:
+					if (intValue(op.c, &c)) result = int(uint32_t(IntConstantList[op.b]) - uint32_t(c)), folded = true;
+					break;
+				default:
+				{
+					bool konst = op.op == OP_ADD_RK || op.op == OP_SUB_RK || op.op == OP_MUL_RK || op.op == OP_AND_RK || op.op == OP_OR_RK || op.op == OP_XOR_RK;
+					if (!intValue(op.b, &b)) break;
+					if (konst) c = IntConstantList[op.c];
+					else if (!intValue(op.c, &c)) break;
+					folded = true;
+					switch (op.op)
+					{
+					case OP_ADD_RR: case OP_ADD_RK: result = int(uint32_t(b) + uint32_t(c)); break;
+					case OP_SUB_RR: case OP_SUB_RK: result = int(uint32_t(b) - uint32_t(c)); break;
+					case OP_MUL_RR: case OP_MUL_RK: result = int(uint32_t(b) * uint32_t(c)); break;
+					case OP_AND_RR: case OP_AND_RK: result = b & c; break;
+					case OP_OR_RR: case OP_OR_RK: result = b | c; break;
+					default: result = b ^ c; break;
+					}
+					break;
+				}
+				}
+				if (folded)
+				{
+					int dest = op.a;
+					if (result >= -32768 && result <= 32767)
+					{
+						op.op = OP_LI;
+						op.i16 = result;
+					}
+					else
+					{
+						op.op = OP_LK;
+						op.i16u = GetConstantInt(result);
+					}
+					op.a = dest;
+					OptStats.Folded++;
+					set(REGT_INT, dest, KNOWN_CONST, 0, (uint32_t)result);
+				}
+				else
+				{
+					forget(REGT_INT, op.a);
+				}
+			}
+			else if (PureDefType(op.op) == REGT_FLOAT)
+			{
+				forget(REGT_FLOAT, op.a);
+			}
+			else
+			{
+				forgetAll();
+			}
+			break;
+		}
+	}
+
+	// Remove pure instructions whose result is overwritten before it is read.
+	for (int i = 0; i < count; i++)
+	{
+		if (dead[i]) continue;
+		int type = PureDefType(Code[i].op);
+		if (type == REGT_NIL || (i > 0 && !KeepsSuccessor(Code[i - 1].op))) continue;
+		int reg = Code[i].a;
+		for (int j = i + 1; j < count && !leader[j]; j++)
+		{
+			if (dead[j]) continue;
+			if (PureReads(Code[j], type, reg)) break;
+			if (PureDefType(Code[j].op) == type && Code[j].a == reg)
+			{
+				dead[i] = true;
+				break;
+			}
+		}
+	}
+
+	// Jumps to the next instruction do nothing, unless they are part of a
+	// compare and branch pair or of a jump table.
+	for (int i = 1; i < count; i++)
+	{
+		if (Code[i].op == OP_JMP && jumpTarget(i) == i + 1 && KeepsSuccessor(Code[i - 1].op)) dead[i] = true;
+	}
+
+	// Compact the code and fix up jumps and line numbers.
+	TArray<int> remap;
+	remap.Resize(count + 1);
+	int newcount = 0;
+	for (int i = 0; i < count; i++)
+	{
+		remap[i] = newcount;
+		if (!dead[i]) newcount++;
+	}
+	remap[count] = newcount;
+	if (newcount == count && original.Size() == Code.Size() && !memcmp(&original[0], &Code[0], count * sizeof(VMOP)))
+	{
+		return false;
+	}
+
+	TArray<VMOP> newcode;
+	newcode.Reserve(newcount);
+	for (int i = 0; i < count; i++)
+	{
+		if (dead[i]) continue;
+		VMOP op = Code[i];
+		if (op.op == OP_JMP)
+		{
+			op.i24 = remap[jumpTarget(i)] - remap[i] - 1;
+		}
+		newcode[remap[i]] = op;
+	}
+
+	// Check that only instructions handled here were removed or rewritten,
+	// that nothing was taken away from behind an instruction that may skip
+	// it and that all jumps stay inside the function.
+	bool ok = true;
+	for (int i = 0; i < count && ok; i++)
+	{
+		if (dead[i])
+		{
+			int o = original[i].op;
+			ok = PureDefType(o) != REGT_NIL || o == OP_MOVES || o == OP_JMP;
+			ok = ok && (i == 0 || KeepsSuccessor(original[i - 1].op));
+		}
+		else if (original[i].op == OP_JMP)
+		{
+			int target = remap[i] + 1 + newcode[remap[i]].i24;
+			ok = target >= 0 && target <= newcount && newcode[remap[i]].op == OP_JMP;
+		}
+		else
+		{
+			ok = newcode[remap[i]].op == original[i].op || PureDefType(original[i].op) == REGT_INT;
+		}
+	}
+
+	// Calls and jump tables must come through untouched: VTBL, CALL and RESULT
+	// instructions unchanged, every RESULT still right behind its call and
+	// every IJMP still followed by its full table of JMPs.
+	for (int i = 0; i < count && ok; i++)
+	{
+		int op = original[i].op;
+		if (op == OP_VTBL || op == OP_CALL || op == OP_CALL_K || op == OP_RESULT)
+		{
+			ok = !dead[i] && !memcmp(&newcode[remap[i]], &original[i], sizeof(VMOP));
+			if (ok && op == OP_RESULT)
+			{
+				int prev = i > 0 ? original[i - 1].op : OP_NOP;
+				ok = (prev == OP_CALL || prev == OP_CALL_K || prev == OP_RESULT) && !dead[i - 1];
+			}
+		}
+		else if (op == OP_IJMP)
+		{
+			int entries = original[i].b;
+			ok = !dead[i] && i + entries < count;
+			for (int k = 1; k <= entries && ok; k++)
+			{
+				ok = !dead[i + k] && original[i + k].op == OP_JMP && newcode[remap[i] + k].op == OP_JMP;
+			}
+		}
+	}
+	if (!ok)
+	{
+		Code = std::move(original);
+		OptStats.Rejected++;
+		return false;
+	}
+
+	for (auto &line : LineNumbers)
+	{
+		line.InstructionIndex = (uint16_t)remap[line.InstructionIndex];
+	}
+	// Drop statements that no longer contain any code. The last one at a
+	// given index is the one that applies to it.
+	for (int i = LineNumbers.Size() - 2; i >= 0; i--)
+	{
+		if (LineNumbers[i].InstructionIndex == LineNumbers[i + 1].InstructionIndex) LineNumbers.Delete(i);
+	}
+
+	OptStats.Removed += count - newcount;
+	Code = std::move(newcode);
+	return true;
+}
+
 //==========================================================================
 //
 // FFunctionBuildList
@@ -839,6 +1303,7 @@ void FFunctionBuildList::Build()
 {
 	VMDisassemblyDumper disasmdump(VMDisassemblyDumper::Overwrite);
 
+	BeginScriptCompile();
 	for (auto &item : mItems)
 	{
 		// [Player701] Do not emit code for abstract functions
@@ -865,6 +1330,7 @@ void FFunctionBuildList::Build()
 		}
 
 		FScriptPosition::StrictErrors = !item.FromDecorate || strictdecorate;
+		BeginScopeAnalysis();
 		item.Code = item.Code->Resolve(ctx);
 		// If we need extra space, load the frame pointer into a register so that we do not have to call the wasteful LFP instruction more than once.
 		if (item.Function->ExtraSpace > 0)
@@ -901,6 +1367,8 @@ void FFunctionBuildList::Build()
 				sfunc->ArgFlags = item.Func->Variants[0].ArgFlags;
 			}
 
+			FinishScopeAnalysis(item.Func, &buildit);
+
 			// Emit code
 			try
 			{
@@ -908,6 +1376,7 @@ void FFunctionBuildList::Build()
 				buildit.BeginStatement(item.Code);
 				item.Code->Emit(&buildit);
 				buildit.EndStatement();
+				if (vm_optimize) buildit.Optimize();
 				buildit.MakeFunction(sfunc);
 				sfunc->NumArgs = 0;
 				// NumArgs for the VMFunction must be the amount of stack elements, which can differ from the amount of logical function arguments if vectors are in the list.
@@ -951,6 +1420,13 @@ void FFunctionBuildList::Build()
 	VMFunction::CreateRegUseInfo();
 	FScriptPosition::StrictErrors = strictdecorate;
 
+	if (vm_optimize)
+	{
+		DPrintf(DMSG_NOTIFY, "Bytecode optimizer: %d functions, %d of %d instructions removed, %d folded, %d jumps threaded, %d rejected\n",
+			OptStats.Functions, OptStats.Removed, OptStats.Instructions, OptStats.Folded, OptStats.Threaded, OptStats.Rejected);
+		memset(&OptStats, 0, sizeof(OptStats));
+	}
+
 	if (FScriptPosition::ErrorCounter == 0)
 	{
 		if (Args->CheckParm("-dumpjit")) DumpJit(true);
@@ -1224,3 +1700,130 @@ void VMDisassemblyDumper::Flush()
 		fflush(dump);
 	}
 }
+
+//==========================================================================
+//
+// VM interpreter benchmark
+//
+// Builds a few small loops directly as bytecode and runs them through the
+// interpreter, bypassing the JIT, to measure raw dispatch speed. The
+// instruction counts include the JMP that is executed together with each
+// loop's comparison. Functions cannot be freed individually, so the loops
+// are only built once and take the iteration count as their argument.
+//
+//==========================================================================
+
+struct FVMBenchLoop
+{
+	VMFunctionBuilder build{ 0 };
+	int counter, zero;
+
+	FVMBenchLoop()
+	{
+		counter = build.Registers[REGT_INT].Get(1);	// the argument
+		zero = build.Registers[REGT_INT].Get(1);
+		build.Emit(OP_LI, zero, 0);
+	}
+
+	// Everything emitted after this is repeated.
+	void Begin()
+	{
+		loopstart = build.GetAddress();
+	}
+
+	VMScriptFunction *Finish(const char *name)
+	{
+		build.Emit(OP_SUB_RK, counter, counter, build.GetConstantInt(1));
+		build.Emit(OP_LT_RR, CMP_CHECK, zero, counter);
+		build.Backpatch(build.Emit(OP_JMP, 0), loopstart);
+		build.Emit(OP_RET, RET_FINAL, REGT_NIL, 0);
+		static const uint8_t argtypes[] = { REGT_INT };
+		auto func = MakeBenchFunction(build, name);
+		func->NumArgs = 1;
+		func->RegTypes = argtypes;
+		return func;
+	}
+
+	static VMScriptFunction *MakeBenchFunction(VMFunctionBuilder &build, const char *name)
+	{
+		auto func = new VMScriptFunction;
+		build.MakeFunction(func);
+		func->QualifiedName = func->PrintableName = name;
+		func->ScriptCall = VMExec;
+		return func;
+	}
+
+private:
+	size_t loopstart;
+};
+
+CCMD(bench_vm)
+{
+	int iterations = argv.argc() > 1 ? max(1, atoi(argv[1])) : 10000000;
+
+	static struct
+	{
+		VMScriptFunction *func;
+		int instructions;	// per iteration
+	} kernels[3];
+
+	// Rebuild the loops if the functions were deleted along with all others by a restart.
+	if (kernels[0].func == nullptr || VMFunction::AllFunctions.Find(kernels[0].func) == VMFunction::AllFunctions.Size())
+	{
+		// Integer arithmetic.
+		{
+			FVMBenchLoop loop;
+			int sum = loop.build.Registers[REGT_INT].Get(1);
+			loop.build.Emit(OP_LI, sum, 0);
+			loop.Begin();
+			loop.build.Emit(OP_ADD_RR, sum, sum, loop.counter);
+			loop.build.Emit(OP_XOR_RR, sum, sum, loop.zero);
+			kernels[0] = { loop.Finish("bench_vm.Integer"), 5 };
+		}
+
+		// Floating point arithmetic.
+		{
+			FVMBenchLoop loop;
+			int factor = loop.build.Registers[REGT_FLOAT].Get(1);
+			int acc = loop.build.Registers[REGT_FLOAT].Get(1);
+			loop.build.Emit(OP_LKF, factor, loop.build.GetConstantFloat(0.5));
+			loop.build.Emit(OP_LKF, acc, loop.build.GetConstantFloat(1.));
+			loop.Begin();
+			loop.build.Emit(OP_MULF_RR, acc, acc, factor);
+			loop.build.Emit(OP_ADDF_RR, acc, acc, factor);
+			kernels[1] = { loop.Finish("bench_vm.Float"), 5 };
+		}
+
+		// Script to script calls with two arguments.
+		{
+			static const uint8_t calleetypes[] = { REGT_INT, REGT_INT };
+			VMFunctionBuilder callee(0);
+			int arg = callee.Registers[REGT_INT].Get(2);
+			callee.Emit(OP_ADD_RR, arg, arg, arg + 1);
+			callee.Emit(OP_RET, RET_FINAL, REGT_NIL, 0);
+			auto calleefunc = FVMBenchLoop::MakeBenchFunction(callee, "bench_vm.Callee");
+			calleefunc->NumArgs = 2;
+			calleefunc->RegTypes = calleetypes;
+
+			FVMBenchLoop loop;
+			loop.Begin();
+			loop.build.Emit(OP_PARAM, REGT_INT, loop.counter);
+			loop.build.Emit(OP_PARAMI, 1);
+			loop.build.Emit(OP_CALL_K, loop.build.GetConstantAddress(calleefunc), 2, 0);
+			kernels[2] = { loop.Finish("bench_vm.Call"), 8 };
+		}
+	}
+
+	for (auto &k : kernels)
+	{
+		VMValue param = iterations;
+		cycle_t time;
+		time.Reset();
+		time.Clock();
+		VMExec(k.func, &param, 1, nullptr, 0);
+		time.Unclock();
+		double ms = time.TimeMS();
+		double instructions = double(k.instructions) * iterations;
+		Printf("%-20s %10.3f ms  %8.1f M instructions/s\n", k.func->PrintableName, ms, ms > 0 ? instructions / ms / 1000. : 0.);
+	}
+}
@@ -58,6 +58,7 @@ public:
 	void BeginStatement(FxExpression *stmt);
 	void EndStatement();
 	void MakeFunction(VMScriptFunction *func);
+	bool Optimize();
 
 	// Returns the constant register holding the value.
 	unsigned GetConstantInt(int val);
@@ -109,6 +110,8 @@ public:
 	// keep the frame pointer, if needed, in a register because the LFP opcode is hideously inefficient, requiring more than 20 instructions on x64.
 	ExpEmit FramePointer;
 	TArray<FxLocalVariableDeclaration *> ConstructedStructs;
+	// depth of the scoped object stack on entry, if the function creates any scoped objects.
+	ExpEmit ScopeMark;
 
 private:
 	TArray<FStatementInfo> LineNumbers;
@@ -5,6 +5,9 @@
 #include "types.h"
 #include "v_draw.h"
 #include "maps.h"
+#include "stats.h"
+#include "c_dispatch.h"
+#include "printf.h"
 
 
 //==========================================================================
@@ -632,4 +635,61 @@ DEFINE_MAP_AND_IT_S_X(Str_F32 , float    , PARAM_FLOAT       , ACTION_RETURN_FLO
 DEFINE_MAP_AND_IT_S_X(Str_F64 , double   , PARAM_FLOAT       , ACTION_RETURN_FLOAT);
 DEFINE_MAP_AND_IT_S_X(Str_Obj , DObject* , PARAM_OBJPOINTER  , ACTION_RETURN_OBJECT);
 DEFINE_MAP_AND_IT_S_X(Str_Ptr , void*    , PARAM_VOIDPOINTER , ACTION_RETURN_POINTER);
-DEFINE_MAP_AND_IT_S_S();
\ No newline at end of file
+DEFINE_MAP_AND_IT_S_S();
+
+
+//==========================================================================
+//
+// CCMD bench_maps
+//
+// Times insertion, lookup, iteration and removal on the two key types
+// script maps use, at sizes from a thousand up to the given maximum.
+//
+//==========================================================================
+
+template<class KT> static void BenchMap(const char *label, int count, KT (*makekey)(int))
+{
+	TArray<KT> keys(count, true);
+	for (int i = 0; i < count; i++) keys[i] = makekey(i);
+
+	ZSMap<KT, uint32_t> map;
+	cycle_t insert, lookup, iterate, remove;
+	insert.Reset(); lookup.Reset(); iterate.Reset(); remove.Reset();
+
+	insert.Clock();
+	for (int i = 0; i < count; i++) map.Insert(keys[i], i);
+	insert.Unclock();
+
+	uint32_t sum = 0;
+	lookup.Clock();
+	for (int i = 0; i < count; i++)
+	{
+		auto v = map.CheckKey(keys[(unsigned(i) * 7919u) % count]);
+		if (v) sum += *v;
+	}
+	lookup.Unclock();
+
+	ZSMapIterator<KT, uint32_t> it;
+	it.Init(map);
+	iterate.Clock();
+	while (it.Next()) sum += it.GetValue();
+	iterate.Unclock();
+
+	remove.Clock();
+	for (int i = 0; i < count; i++) map.Remove(keys[i]);
+	remove.Unclock();
+
+	auto ns = [=](cycle_t &c) { return c.TimeMS() * 1e6 / count; };
+	Printf("%-6s %8d  insert %6.1f  lookup %6.1f  iterate %6.1f  remove %6.1f ns/op (%u)\n",
+		label, count, ns(insert), ns(lookup), ns(iterate), ns(remove), sum);
+}
+
+CCMD(bench_maps)
+{
+	int max = argv.argc() > 1 ? atoi(argv[1]) : 1000000;
+	for (int count = 1000; count <= max; count *= 10)
+	{
+		BenchMap<uint32_t>("Int", count, [](int i) { return uint32_t(i); });
+		BenchMap<FString>("String", count, [](int i) { FString s; s.Format("key%d", i); return s; });
+	}
+}
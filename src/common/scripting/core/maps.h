@@ -35,29 +35,23 @@ template<class KT, class VT>
 struct ZSMapIterator
 {
     RefCountedPtr<ZSMapInfo> info;
-    TMapIterator<KT,VT>  *it = nullptr;
     typename ZSMap<KT,VT>::Pair *p = nullptr;
+    hash_t position = 0;
 
     typedef KT KeyType;
     typedef VT ValueType;
 
     int rev = 0;
 
-    ~ZSMapIterator()
-    {
-        if(it) delete it;
-    }
-
     bool Valid()
     {
-        return it && p && info.get() && info->self && info->rev == rev;
+        return p && info.get() && info->self && info->rev == rev;
     }
 
     bool ReInit()
     {
         if(info.get() && info->self) {
-            if(it) delete it;
-            it = new TMapIterator<KT,VT>(*static_cast<ZSMap<KT,VT>*>(info->self));
+            position = 0;
             rev = info->rev;
             p = nullptr;
             return true;
@@ -73,10 +67,10 @@ struct ZSMapIterator
 
     bool Next()
     {
-        if(it && info.get() && info->self && info->rev == rev)
+        if(info.get() && info->self && info->rev == rev)
         {
             p = nullptr;
-            return it->NextPair(p);
+            return static_cast<ZSMap<KT,VT>*>(info->self)->NextPair(position, p);
         }
         else
         {
@@ -107,4 +101,7 @@ struct ZSMapIterator
             ThrowAbortException(X_FORMAT_ERROR,p ? "MapIterator::GetKey called from invalid iterator" : "MapIterator::GetKey called from invalid position");
         }
     }
-};
\ No newline at end of file
+};
+
+// PMapIterator reserves sizeof(ZSFMap) for an iterator.
+static_assert(sizeof(ZSMapIterator<int, int>) <= sizeof(ZSFMap), "ZSMapIterator does not fit in a map sized slot");
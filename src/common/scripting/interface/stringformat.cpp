@@ -40,6 +40,9 @@
 #include "v_font.h"
 #include "types.h"
 #include "utf8.h"
+#include "stats.h"
+#include "c_dispatch.h"
+#include "printf.h"
 
 
 
@@ -48,7 +51,7 @@ FString FStringFormat(VM_ARGS, int offset)
 	PARAM_VA_POINTER(va_reginfo)	// Get the hidden type information array
 	assert(va_reginfo[offset] == REGT_STRING);
 
-	FString fmtstring = param[offset].s().GetChars();
+	const FString &fmtstring = param[offset].s();
 
 	param += offset;
 	numparam -= offset;
@@ -235,7 +238,11 @@ FString FStringFormat(VM_ARGS, int offset)
 			}
 			else
 			{
-				output += c;
+				// Copy the entire run of plain text up to the next format specifier at once.
+				size_t end = i + 1;
+				while (end < fmtstring.Len() && fmtstring[end] != '%') end++;
+				output.AppendCStrPart(fmtstring.GetChars() + i, end - i);
+				i = end - 1;
 			}
 		}
 	}
@@ -649,3 +656,62 @@ DEFINE_ACTION_FUNCTION_NATIVE(FStringStruct, GetNextCodePoint, StringNextCodePoi
 }
 
 
+
+//==========================================================================
+//
+// CCMD bench_strings
+//
+// Times the string operations scripts use most and reports how many
+// heap allocations each of them costs per call.
+//
+//==========================================================================
+
+CCMD(bench_strings)
+{
+	int count = argv.argc() > 1 ? atoi(argv[1]) : 100000;
+	if (count <= 0) count = 100000;
+
+	auto run = [=](const char *label, auto &&func)
+	{
+		cycle_t clock;
+		clock.Reset();
+		unsigned allocs = FString::AllocationCount();
+		clock.Clock();
+		for (int i = 0; i < count; i++) func(i);
+		clock.Unclock();
+		allocs = FString::AllocationCount() - allocs;
+		Printf("%-12s %8.3f ms  %6.2f allocs/op\n", label, clock.TimeMS(), double(allocs) / count);
+	};
+
+	FString fmt = "Health: %d, speed: %.2f";
+	FString text = "The quick brown fox jumps over the lazy dog";
+	const uint8_t reginfo[] = { REGT_STRING, REGT_INT, REGT_FLOAT };
+
+	run("Format", [&](int i)
+	{
+		VMValue params[] = { &fmt, i, i * 0.5, (void*)reginfo };
+		FString s = FStringFormat(VM_INVOKE(params, 4, nullptr, 0, reginfo), 0);
+	});
+	run("Mid", [&](int i)
+	{
+		FString s = text.Mid(i & 15, 8);
+	});
+	run("Mid (whole)", [&](int i)
+	{
+		FString s = text.Mid(0);
+	});
+	run("Substitute", [&](int i)
+	{
+		FString s = text;
+		s.Substitute("fox", "cat");
+	});
+	run("Append", [&](int i)
+	{
+		FString s;
+		for (int j = 0; j < 16; j++) s += "word ";
+	});
+	run("NameToString", [&](int i)
+	{
+		FString s = VM_NameToString(NAME_None + 1 + (i & 63));
+	});
+}
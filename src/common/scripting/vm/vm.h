@@ -59,6 +59,7 @@ extern FMemArena ClassDataAllocator;
 void JitRelease();
 
 extern void (*VM_CastSpriteIDToString)(FString* a, unsigned int b);
+const FString &VM_NameToString(int index);
 
 
 typedef unsigned char		VM_UBYTE;
@@ -529,6 +530,13 @@ private:
 int VMCall(VMFunction *func, VMValue *params, int numparams, VMReturn *results, int numresults/*, VMException **trap = NULL*/);
 int VMCallWithDefaults(VMFunction *func, TArray<VMValue> &params, VMReturn *results, int numresults/*, VMException **trap = NULL*/);
 
+// Call stack profiler, toggled with the vmprofile console command.
+extern bool VMProfiling;
+extern const void *VMProfileCallSite;
+bool VMProfileEnter(const void *key, const void *site);
+void VMProfileSetName(const FString &name);
+void VMProfileLeave();
+
 inline int VMCallAction(VMFunction *func, VMValue *params, int numparams, VMReturn *results, int numresults/*, VMException **trap = NULL*/)
 {
 	return VMCall(func, params, numparams, results, numresults);
@@ -50,6 +50,35 @@ extern int VMCalls[10];
 // THe sprite ID to string cast is game specific so let's do it with a callback to remove the dependency and allow easier reuse.
 void (*VM_CastSpriteIDToString)(FString* a, unsigned int b) = [](FString* a, unsigned int b) { a->Format("%d", b); };
 
+//===========================================================================
+//
+// VM_NameToString
+//
+// Name to string casts are common in scripts that build messages or
+// dictionary keys. Names are never deleted, so the string for each one
+// is created once and shared by reference from then on.
+//
+//===========================================================================
+
+const FString &VM_NameToString(int index)
+{
+	static TArray<FString> NameStrings;
+	static const FString Empty;
+
+	FName name = FName(ENamedName(index));
+	if (!name.IsValidName()) return Empty;
+	if ((unsigned)index >= NameStrings.Size())
+	{
+		NameStrings.Resize(index + 1);
+	}
+	FString &str = NameStrings[index];
+	if (str.IsEmpty())
+	{
+		str = name.GetChars();
+	}
+	return str;
+}
+
 // intentionally implemented in a different source file to prevent inlining.
 #if 0
 void ThrowVMException(VMException *x);
@@ -63,7 +92,7 @@ void ThrowVMException(VMException *x);
 
 #if COMPGOTO
 #define OP(x)	x
-#define NEXTOP	do { pc++; unsigned op = pc->op; a = pc->a; goto *ops[op]; } while(0)
+#define NEXTOP	do { pc++; unsigned op = pc->op; a = pc->a; VM_COUNTOP(op); goto *ops[op]; } while(0)
 #else
 #define OP(x)	case OP_##x
 #define NEXTOP	pc++; break
@@ -104,6 +133,17 @@ void ThrowVMException(VMException *x);
 		pc += 1; \
 	}
 
+// The checked engine can record a histogram of consecutively executed
+// opcodes to find candidates for fused dispatch.
+TArray<uint64_t> VMOpPairs;
+static int VMLastOp;
+
+static void VMCountOp(int op)
+{
+	VMOpPairs[VMLastOp * 256 + op]++;
+	VMLastOp = op;
+}
+
 #define GETADDR(a,o,x) \
 	if (a == NULL) { ThrowAbortException(x, nullptr); return 0; } \
 	ptr = (VM_SBYTE *)a + o
@@ -119,10 +159,13 @@ void ThrowVMException(VMException *x);
 #endif
 #undef assert
 #include <assert.h>
+#define VM_COUNTOP(op)	(VMOpPairs.Size() > 0 ? VMCountOp(op) : (void)0)
 struct VMExec_Checked
 {
 #include "vmexec.h"
 };
+#undef VM_COUNTOP
+#define VM_COUNTOP(op)	((void)0)
 #if WAS_NDEBUG
 #define NDEBUG
 #endif
@@ -185,6 +228,50 @@ void VMSelectEngine(EVMEngine engine)
 	}
 }
 
+//===========================================================================
+//
+// VMRecordOpPairs
+//
+// Starts or stops the opcode pair histogram. Only the checked engine
+// records it, so interpreted functions are switched over while recording
+// and back to the selected engine afterwards.
+//
+//===========================================================================
+
+void VMRecordOpPairs(bool on)
+{
+	auto from = on ? VMExec : VMExec_Checked::Exec;
+	auto to = on ? VMExec_Checked::Exec : VMExec;
+
+	for (auto f : VMFunction::AllFunctions)
+	{
+		if (f->VarFlags & VARF_Native) continue;
+		auto sfunc = static_cast<VMScriptFunction *>(f);
+		if (sfunc->ScriptCall == from) sfunc->ScriptCall = to;
+		if (sfunc->UnprofiledCall == from) sfunc->UnprofiledCall = to;
+	}
+	if (on)
+	{
+		VMOpPairs.Resize(256 * 256);
+		memset(VMOpPairs.Data(), 0, VMOpPairs.Size() * sizeof(uint64_t));
+		VMLastOp = 0;
+	}
+	else
+	{
+		VMOpPairs.Reset();
+	}
+}
+
+// Functions that get called for the first time while recording are
+// switched over as well, so they are not missing from the histogram.
+void VMRecordOpPairs(VMScriptFunction *func)
+{
+	if (VMOpPairs.Size() > 0 && func->ScriptCall == VMExec)
+	{
+		func->ScriptCall = VMExec_Checked::Exec;
+	}
+}
+
 //===========================================================================
 //
 // VMFillParams
@@ -70,7 +70,7 @@ static int ExecScriptFunc(VMFrameStack *stack, VMReturn *ret, int numret)
 	{
 #if !COMPGOTO
 	VM_UBYTE op;
-	for(;;) switch(op = pc->op, a = pc->a, op)
+	for(;;) switch(op = pc->op, a = pc->a, VM_COUNTOP(op), op)
 #else
 	pc--;
 	NEXTOP;
@@ -737,18 +737,19 @@ static int ExecScriptFunc(VMFrameStack *stack, VMReturn *ret, int numret)
 		pc += 1 + JMPOFS(pc+1);
 		NEXTOP;
 	OP(PARAMI):
-		assert(f->NumParam < sfunc->MaxParam);
-		{
-			VMValue *param = &reg.param[f->NumParam++];
-			::new(param) VMValue(ABCs);
-		}
-		NEXTOP;
 	OP(PARAM):
-		assert(f->NumParam < sfunc->MaxParam);
+		// Argument lists are runs of PARAM and PARAMI ending in a call, so
+		// the whole run is pushed here instead of dispatching each one.
+		for (;;)
 		{
+			assert(f->NumParam < sfunc->MaxParam);
 			VMValue *param = &reg.param[f->NumParam++];
 			b = BC;
-			if (a == REGT_NIL)
+			if (pc->op == OP_PARAMI)
+			{
+				::new(param) VMValue(ABCs);
+			}
+			else if (a == REGT_NIL)
 			{
 				::new(param) VMValue();
 			}
@@ -837,6 +838,13 @@ static int ExecScriptFunc(VMFrameStack *stack, VMReturn *ret, int numret)
 					break;
 				}
 			}
+			if (pc[1].op != OP_PARAM && pc[1].op != OP_PARAMI)
+			{
+				break;
+			}
+			pc++;
+			a = pc->a;
+			VM_COUNTOP(pc->op);
 		}
 		NEXTOP;
 	OP(VTBL):
@@ -903,6 +911,7 @@ static int ExecScriptFunc(VMFrameStack *stack, VMReturn *ret, int numret)
 			else
 			{
 				auto sfunc1 = static_cast<VMScriptFunction *>(call);
+				if (VMProfiling) VMProfileCallSite = pc;
 				numret1 = sfunc1->ScriptCall(sfunc1, reg.param + f->NumParam - b, b, returns, C);
 			}
 			assert(numret1 == C && "Number of parameters returned differs from what was expected by the caller");
@@ -2119,8 +2128,7 @@ static void DoCast(const VMRegisters &reg, const VMFrame *f, int a, int b, int c
 	case CAST_N2S:
 	{
 		ASSERTS(a); ASSERTD(b);
-		FName name = FName(ENamedName(reg.d[b]));
-		reg.s[a] = name.IsValidName() ? name.GetChars() : "";
+		reg.s[a] = VM_NameToString(reg.d[b]);
 		break; 
 	}
 
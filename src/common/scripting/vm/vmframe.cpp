@@ -33,6 +33,7 @@
 */
 
 #include <new>
+#include <algorithm>
 #include "dobject.h"
 #include "v_text.h"
 #include "stats.h"
@@ -43,6 +44,7 @@
 #include "jit.h"
 #include "c_cvars.h"
 #include "version.h"
+#include "files.h"
 
 #ifdef HAVE_VM_JIT
 #ifdef __DragonFly__
@@ -306,6 +308,7 @@ void VMScriptFunction::JitCompile()
 		{
 			ScriptCall = VMExec;
 		}
+		VMRecordOpPairs(this);
 	}
 }
 
@@ -320,6 +323,12 @@ int VMScriptFunction::FirstScriptCall(VMFunction *func, VMValue *params, int num
 	}
 	
 	static_cast<VMScriptFunction*>(func)->JitCompile();
+	if (VMProfiling)
+	{
+		// The profiler frame for this call has already been pushed.
+		VMProfileWrap(static_cast<VMScriptFunction*>(func));
+		return static_cast<VMScriptFunction*>(func)->UnprofiledCall(func, params, numparams, ret, numret);
+	}
 
 	return func->ScriptCall(func, params, numparams, ret, numret);
 }
@@ -769,6 +778,327 @@ ADD_STAT(VM)
 	return FStringf("VM time in last 10 tics: %f ms, %d calls, peak = %f ms", added, addedc, peak);
 }
 
+//===========================================================================
+//
+// Call stack profiler
+//
+// While active, every script function's ScriptCall is routed through
+// ProfiledScriptCall, which maintains a shadow call stack alongside the
+// VMFrameStack. The interpreter notes the calling instruction so that
+// frames can be tagged with the line from the caller's FStatementInfo;
+// JIT-compiled callers do not provide this. ACS scripts push their own
+// frame from DLevelScript::RunScript.
+//
+// Time is sampled from the clock at every frame transition and charged
+// to the frame on top of the shadow stack, so native functions count
+// toward the script that called them. When inactive the only cost is
+// one flag test per interpreted call.
+//
+//===========================================================================
+
+struct FVMProfileNode
+{
+	const void *Key;
+	const void *Site;
+	VMScriptFunction *Func;	// for resolving the line of calls made from this frame
+	int Parent;
+	int CallLine;			// line in the parent frame this was called from, or -1
+	FString Name;
+	double Time;			// self time in ms
+	TArray<int> Children;
+};
+
+bool VMProfiling;
+const void *VMProfileCallSite;
+static TArray<FVMProfileNode> ProfileNodes;
+static TArray<int> ProfileStack;
+static cycle_t ProfileClock;
+static double ProfileTotal;
+
+static void VMProfileSample()
+{
+	ProfileClock.Unclock();
+	double time = ProfileClock.TimeMS();
+	ProfileClock.ResetAndClock();
+	if (ProfileStack.Size() > 0)
+	{
+		ProfileNodes[ProfileStack.Last()].Time += time;
+		ProfileTotal += time;
+	}
+}
+
+static void VMProfileReset()
+{
+	ProfileNodes.Clear();
+	ProfileStack.Clear();
+	ProfileTotal = 0;
+	// Node 0 is the root all call paths hang off.
+	ProfileNodes.Reserve(1);
+	ProfileNodes[0].Key = nullptr;
+	ProfileNodes[0].Site = nullptr;
+	ProfileNodes[0].Func = nullptr;
+	ProfileNodes[0].Parent = -1;
+	ProfileNodes[0].CallLine = -1;
+	ProfileNodes[0].Time = 0;
+}
+
+//==========================================================================
+//
+// VMProfileEnter
+//
+// Pushes a frame identified by key and call site. Returns true if this
+// call path has not been seen before, in which case the caller should
+// name it with VMProfileSetName.
+//
+//==========================================================================
+
+bool VMProfileEnter(const void *key, const void *site)
+{
+	VMProfileSample();
+	if (ProfileNodes.Size() == 0)
+	{
+		VMProfileReset();
+	}
+	int parent = ProfileStack.Size() > 0 ? ProfileStack.Last() : 0;
+	for (int child : ProfileNodes[parent].Children)
+	{
+		if (ProfileNodes[child].Key == key && ProfileNodes[child].Site == site)
+		{
+			ProfileStack.Push(child);
+			return false;
+		}
+	}
+	int node = ProfileNodes.Reserve(1);
+	auto &n = ProfileNodes[node];
+	n.Key = key;
+	n.Site = site;
+	n.Func = nullptr;
+	n.Parent = parent;
+	n.CallLine = -1;
+	n.Time = 0;
+	ProfileNodes[parent].Children.Push(node);
+	ProfileStack.Push(node);
+	return true;
+}
+
+void VMProfileSetName(const FString &name)
+{
+	if (ProfileStack.Size() > 0)
+	{
+		auto &node = ProfileNodes[ProfileStack.Last()];
+		node.Name = name;
+		// Frame names must not contain the separator.
+		node.Name.ReplaceChars(';', ',');
+	}
+}
+
+void VMProfileLeave()
+{
+	VMProfileSample();
+	// The stack may have been cleared by a restart while this frame was active.
+	if (ProfileStack.Size() > 0)
+	{
+		ProfileStack.Pop();
+	}
+}
+
+static int ProfiledScriptCall(VMFunction *func, VMValue *params, int numparams, VMReturn *ret, int numret)
+{
+	auto sfunc = static_cast<VMScriptFunction *>(func);
+	auto site = static_cast<const VMOP *>(VMProfileCallSite);
+	VMProfileCallSite = nullptr;
+
+	if (VMProfileEnter(sfunc, site))
+	{
+		auto &node = ProfileNodes[ProfileStack.Last()];
+		auto caller = ProfileNodes[node.Parent].Func;
+		node.Func = sfunc;
+		VMProfileSetName(sfunc->PrintableName);
+		if (caller != nullptr && site >= caller->Code && site < caller->Code + caller->CodeSize)
+		{
+			node.CallLine = caller->PCToLine(site);
+		}
+	}
+
+	struct FLeave { ~FLeave() { VMProfileLeave(); } } leave;
+	return sfunc->UnprofiledCall(func, params, numparams, ret, numret);
+}
+
+void VMProfileWrap(VMScriptFunction *func)
+{
+	if (func->ScriptCall != &ProfiledScriptCall)
+	{
+		func->UnprofiledCall = func->ScriptCall;
+		func->ScriptCall = &ProfiledScriptCall;
+	}
+}
+
+static void VMProfileStart()
+{
+	if (VMProfiling) return;
+	for (auto f : VMFunction::AllFunctions)
+	{
+		if (!(f->VarFlags & VARF_Native) && f->ScriptCall != nullptr)
+		{
+			VMProfileWrap(static_cast<VMScriptFunction *>(f));
+		}
+	}
+	ProfileStack.Clear();
+	ProfileClock.ResetAndClock();
+	VMProfiling = true;
+}
+
+static void VMProfileStop()
+{
+	if (!VMProfiling) return;
+	VMProfiling = false;
+	VMProfileCallSite = nullptr;
+	for (auto f : VMFunction::AllFunctions)
+	{
+		if (f->ScriptCall == &ProfiledScriptCall)
+		{
+			f->ScriptCall = static_cast<VMScriptFunction *>(f)->UnprofiledCall;
+		}
+	}
+}
+
+//==========================================================================
+//
+// VMProfileDump
+//
+// Writes one line per call path in the collapsed stack format read by
+// flamegraph.pl and compatible tools: the frames from the outermost in,
+// separated by semicolons, followed by the self time in microseconds.
+//
+//==========================================================================
+
+static int VMProfileDump(FileWriter *fw)
+{
+	int lines = 0;
+	TArray<int> path;
+	FString out;
+
+	for (unsigned i = 1; i < ProfileNodes.Size(); i++)
+	{
+		auto usec = (unsigned long long)(ProfileNodes[i].Time * 1000. + 0.5);
+		if (usec == 0) continue;
+
+		path.Clear();
+		for (int n = i; n > 0; n = ProfileNodes[n].Parent)
+		{
+			path.Push(n);
+		}
+		out = "";
+		for (int j = path.Size() - 1; j >= 0; j--)
+		{
+			auto &node = ProfileNodes[path[j]];
+			out += node.Name;
+			if (j > 0)
+			{
+				int line = ProfileNodes[path[j - 1]].CallLine;
+				if (line >= 0) out.AppendFormat(":%d", line);
+				out += ';';
+			}
+		}
+		fw->Printf("%s %llu\n", out.GetChars(), usec);
+		lines++;
+	}
+	return lines;
+}
+
+CCMD(vmprofile)
+{
+	if (argv.argc() >= 2)
+	{
+		if (stricmp(argv[1], "start") == 0)
+		{
+			if (ProfileNodes.Size() == 0) VMProfileReset();
+			VMProfileStart();
+			Printf("VM profiling started\n");
+			return;
+		}
+		else if (stricmp(argv[1], "stop") == 0)
+		{
+			VMProfileStop();
+			Printf("VM profiling stopped, %.1f ms recorded\n", ProfileTotal);
+			return;
+		}
+		else if (stricmp(argv[1], "clear") == 0)
+		{
+			VMProfileReset();
+			return;
+		}
+		else if (stricmp(argv[1], "dump") == 0)
+		{
+			const char *filename = argv.argc() >= 3 ? argv[2] : "vmprofile.txt";
+			FileWriter *fw = FileWriter::Open(filename);
+			if (fw == nullptr)
+			{
+				Printf("Unable to open %s\n", filename);
+				return;
+			}
+			int lines = VMProfileDump(fw);
+			delete fw;
+			Printf("Wrote %d stacks (%.1f ms) to %s\n", lines, ProfileTotal, filename);
+			return;
+		}
+	}
+	Printf("Usage: vmprofile <start|stop|clear|dump [filename]>\n");
+}
+
+//-----------------------------------------------------------------------------
+//
+// Opcode pair histogram of the interpreter, for finding sequences
+// worth handling in a single dispatch. JIT-compiled functions are not
+// counted.
+//
+//-----------------------------------------------------------------------------
+
+CCMD(vmoppairs)
+{
+	if (argv.argc() >= 2)
+	{
+		if (stricmp(argv[1], "start") == 0)
+		{
+			VMRecordOpPairs(true);
+			return;
+		}
+		else if (stricmp(argv[1], "stop") == 0)
+		{
+			VMRecordOpPairs(false);
+			return;
+		}
+		else if (stricmp(argv[1], "list") == 0)
+		{
+			if (VMOpPairs.Size() == 0)
+			{
+				Printf("Opcode pairs are not being recorded\n");
+				return;
+			}
+			unsigned count = argv.argc() >= 3 ? max(1, atoi(argv[2])) : 20;
+			TArray<unsigned> pairs;
+			uint64_t total = 0;
+			for (unsigned i = 0; i < VMOpPairs.Size(); i++)
+			{
+				if (VMOpPairs[i] > 0)
+				{
+					pairs.Push(i);
+					total += VMOpPairs[i];
+				}
+			}
+			std::sort(pairs.begin(), pairs.end(), [](unsigned a, unsigned b) { return VMOpPairs[a] > VMOpPairs[b]; });
+			for (unsigned i = 0; i < pairs.Size() && i < count; i++)
+			{
+				unsigned first = pairs[i] / 256, second = pairs[i] % 256;
+				Printf("%-10s %-10s %12llu %6.2f%%\n", first < NUM_OPS ? OpInfo[first].Name : "?", second < NUM_OPS ? OpInfo[second].Name : "?",
+					(unsigned long long)VMOpPairs[pairs[i]], 100. * VMOpPairs[pairs[i]] / total);
+			}
+			return;
+		}
+	}
+	Printf("Usage: vmoppairs <start|stop|list [count]>\n");
+}
+
 //-----------------------------------------------------------------------------
 //
 //
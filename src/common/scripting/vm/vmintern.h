@@ -434,6 +434,10 @@ enum EVMEngine
 void VMSelectEngine(EVMEngine engine);
 extern int (*VMExec)(VMFunction *func, VMValue *params, int numparams, VMReturn *ret, int numret);
 void VMFillParams(VMValue *params, VMFrame *callee, int numparam);
+void VMProfileWrap(VMScriptFunction *func);
+void VMRecordOpPairs(bool on);
+void VMRecordOpPairs(VMScriptFunction *func);
+extern TArray<uint64_t> VMOpPairs;
 
 void VMDumpConstants(FILE *out, const VMScriptFunction *func);
 void VMDisasm(FILE *out, const VMOP *code, int codesize, const VMScriptFunction *func);
@@ -475,6 +479,7 @@ public:
 	TArray<FTypeAndOffset> SpecialInits;	// list of all contents on the extra stack which require construction and destruction
 
 	bool blockJit = false; // function triggers Jit bugs, block compilation until bugs are fixed
+	int(*UnprofiledCall)(VMFunction *func, VMValue *params, int numparams, VMReturn *ret, int numret) = nullptr;	// ScriptCall while the profiler is active
 
 	void InitExtra(void *addr);
 	void DestroyExtra(void *addr);
@@ -445,6 +445,7 @@ extern int upscalemask;
 void UpdateUpscaleMask();
 
 void calcShouldUpscale(FGameTexture* tex);
+void FlushUpscaleQueue();
 inline int shouldUpscale(FGameTexture* tex, EUpscaleFlags UseType)
 {
 	// This only checks the global scale mask and the texture's validation for upscaling. Everything else has been done up front elsewhere.
@@ -24,6 +24,9 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#ifndef NO_SSE
+#include <emmintrin.h>
+#endif
 
 #define MASK_2     0x0000FF00
 #define MASK_13    0x00FF00FF
@@ -58,6 +61,52 @@ static inline int Diff(uint32_t c1, uint32_t c2)
     return yuv_diff(rgb_to_yuv(c1), rgb_to_yuv(c2));
 }
 
+/* Converts a whole image to YUV, so that every pixel needs only one table lookup */
+uint32_t *hqxConvertToYUV(const uint32_t *sp, int spL, int Xres, int Yres);
+
+#ifndef NO_SSE
+/* yuv_diff for 4 pixels at once, returns one bit per pixel */
+static inline int yuv_diff4(__m128i yuv1, __m128i yuv2)
+{
+    const __m128i masks[3] = { _mm_set1_epi32(Ymask), _mm_set1_epi32(Umask), _mm_set1_epi32(Vmask) };
+    const __m128i thresholds[3] = { _mm_set1_epi32(trY), _mm_set1_epi32(trU), _mm_set1_epi32(trV) };
+    __m128i result = _mm_setzero_si128();
+
+    for (int i = 0; i < 3; i++)
+    {
+        __m128i d = _mm_sub_epi32(_mm_and_si128(yuv1, masks[i]), _mm_and_si128(yuv2, masks[i]));
+        __m128i sign = _mm_srai_epi32(d, 31);
+        d = _mm_sub_epi32(_mm_xor_si128(d, sign), sign);
+        result = _mm_or_si128(result, _mm_cmpgt_epi32(d, thresholds[i]));
+    }
+    return _mm_movemask_ps(_mm_castsi128_ps(result));
+}
+#endif
+
+/* Pattern of the neighbours in y[1..9] that differ from the center y[5], one bit per neighbour.
+   Identical pixels always have identical YUV values, so no separate equality check is needed. */
+static inline int hqx_pattern(const uint32_t *y)
+{
+#ifndef NO_SSE
+    const __m128i center = _mm_set1_epi32(y[5]);
+    const __m128i lo = _mm_setr_epi32(y[1], y[2], y[3], y[4]);
+    const __m128i hi = _mm_setr_epi32(y[6], y[7], y[8], y[9]);
+    return yuv_diff4(center, lo) | (yuv_diff4(center, hi) << 4);
+#else
+    int pattern = 0;
+    int flag = 1;
+
+    for (int k=1; k<=9; k++)
+    {
+        if (k==5) continue;
+        if (yuv_diff(y[5], y[k]))
+            pattern |= flag;
+        flag <<= 1;
+    }
+    return pattern;
+#endif
+}
+
 /* Interpolate functions */
 static inline uint32_t Interpolate_2(uint32_t c1, int w1, uint32_t c2, int w2, int s)
 {
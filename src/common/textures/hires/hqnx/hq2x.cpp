@@ -72,14 +72,17 @@
 
 HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres )
 {
-    int  i, j, k;
+    int  i, j;
     int  prevline, nextline;
+    int  yprevline, ynextline;
     uint32_t  w[10];
+    uint32_t  y[10];
     int dpL = (drb >> 2);
     int spL = (srb >> 2);
     uint8_t *sRowP = (uint8_t *) sp;
     uint8_t *dRowP = (uint8_t *) dp;
-    uint32_t yuv1, yuv2;
+    uint32_t *yuvImage = hqxConvertToYUV(sp, spL, Xres, Yres);
+    uint32_t *yp = yuvImage;
 
     //   +----+----+----+
     //   |    |    |    |
@@ -96,24 +99,35 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
     {
         if (j>0)      prevline = -spL; else prevline = 0;
         if (j<Yres-1) nextline =  spL; else nextline = 0;
+        if (j>0)      yprevline = -Xres; else yprevline = 0;
+        if (j<Yres-1) ynextline =  Xres; else ynextline = 0;
 
         for (i=0; i<Xres; i++)
         {
             w[2] = *(sp + prevline);
             w[5] = *sp;
             w[8] = *(sp + nextline);
+            y[2] = *(yp + yprevline);
+            y[5] = *yp;
+            y[8] = *(yp + ynextline);
 
             if (i>0)
             {
                 w[1] = *(sp + prevline - 1);
                 w[4] = *(sp - 1);
                 w[7] = *(sp + nextline - 1);
+                y[1] = *(yp + yprevline - 1);
+                y[4] = *(yp - 1);
+                y[7] = *(yp + ynextline - 1);
             }
             else
             {
                 w[1] = w[2];
                 w[4] = w[5];
                 w[7] = w[8];
+                y[1] = y[2];
+                y[4] = y[5];
+                y[7] = y[8];
             }
 
             if (i<Xres-1)
@@ -121,31 +135,21 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 w[3] = *(sp + prevline + 1);
                 w[6] = *(sp + 1);
                 w[9] = *(sp + nextline + 1);
+                y[3] = *(yp + yprevline + 1);
+                y[6] = *(yp + 1);
+                y[9] = *(yp + ynextline + 1);
             }
             else
             {
                 w[3] = w[2];
                 w[6] = w[5];
                 w[9] = w[8];
+                y[3] = y[2];
+                y[6] = y[5];
+                y[9] = y[8];
             }
 
-            int pattern = 0;
-            int flag = 1;
-
-            yuv1 = rgb_to_yuv(w[5]);
-
-            for (k=1; k<=9; k++)
-            {
-                if (k==5) continue;
-
-                if ( w[k] != w[5] )
-                {
-                    yuv2 = rgb_to_yuv(w[k]);
-                    if (yuv_diff(yuv1, yuv2))
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }
+            int pattern = hqx_pattern(y);
 
             switch (pattern)
             {
@@ -308,7 +312,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 50:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -326,7 +330,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_22
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -341,7 +345,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -355,7 +359,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 10:
                 case 138:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -428,7 +432,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 54:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -446,7 +450,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_22
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -461,7 +465,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -475,7 +479,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 11:
                 case 139:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -491,7 +495,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 19:
                 case 51:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL00_11
                             PIXEL01_10
@@ -509,7 +513,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 178:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                             PIXEL11_12
@@ -526,7 +530,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 85:
                     {
                         PIXEL00_20
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL01_11
                             PIXEL11_10
@@ -544,7 +548,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_20
                         PIXEL01_22
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL10_12
                             PIXEL11_10
@@ -561,7 +565,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                             PIXEL11_11
@@ -576,7 +580,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 73:
                 case 77:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL00_12
                             PIXEL10_10
@@ -593,7 +597,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 42:
                 case 170:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                             PIXEL10_11
@@ -610,7 +614,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 14:
                 case 142:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                             PIXEL01_12
@@ -691,7 +695,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 26:
                 case 31:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -699,7 +703,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -715,7 +719,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 214:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -724,7 +728,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -739,7 +743,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -747,7 +751,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -760,7 +764,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 74:
                 case 107:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -769,7 +773,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -782,7 +786,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 27:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -798,7 +802,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 86:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -815,7 +819,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_21
                         PIXEL01_22
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -829,7 +833,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -843,7 +847,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 30:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -860,7 +864,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_22
                         PIXEL01_10
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -874,7 +878,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -887,7 +891,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 75:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -998,7 +1002,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 58:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1006,7 +1010,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1021,7 +1025,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 83:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1030,7 +1034,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1044,7 +1048,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1052,7 +1056,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1064,7 +1068,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 202:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1073,7 +1077,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1086,7 +1090,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 78:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1095,7 +1099,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1108,7 +1112,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 154:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1116,7 +1120,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1131,7 +1135,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 114:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1140,7 +1144,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1154,7 +1158,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1162,7 +1166,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1174,7 +1178,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 90:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1182,7 +1186,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1190,7 +1194,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1198,7 +1202,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1211,7 +1215,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 55:
                 case 23:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL00_11
                             PIXEL01_0
@@ -1229,7 +1233,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 150:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                             PIXEL11_12
@@ -1246,7 +1250,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 212:
                     {
                         PIXEL00_20
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL01_11
                             PIXEL11_0
@@ -1264,7 +1268,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_20
                         PIXEL01_22
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL10_12
                             PIXEL11_0
@@ -1281,7 +1285,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                             PIXEL11_11
@@ -1296,7 +1300,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 109:
                 case 105:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL00_12
                             PIXEL10_0
@@ -1313,7 +1317,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 171:
                 case 43:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                             PIXEL10_11
@@ -1330,7 +1334,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 143:
                 case 15:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                             PIXEL01_12
@@ -1348,7 +1352,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -1361,7 +1365,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 203:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -1377,7 +1381,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 62:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -1394,7 +1398,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_11
                         PIXEL01_10
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -1407,7 +1411,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 118:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -1424,7 +1428,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_12
                         PIXEL01_22
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -1438,7 +1442,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -1451,7 +1455,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 155:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -1532,7 +1536,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1540,7 +1544,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -1552,7 +1556,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 158:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1560,7 +1564,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -1574,7 +1578,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 234:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1583,7 +1587,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -1597,7 +1601,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 242:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1606,7 +1610,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -1618,7 +1622,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 59:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -1626,7 +1630,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1642,7 +1646,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -1650,7 +1654,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1663,7 +1667,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 87:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -1672,7 +1676,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1684,7 +1688,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 79:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -1693,7 +1697,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1706,7 +1710,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 122:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1714,7 +1718,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1722,7 +1726,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -1730,7 +1734,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1742,7 +1746,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 94:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1750,7 +1754,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -1758,7 +1762,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1766,7 +1770,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1778,7 +1782,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 218:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1786,7 +1790,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1794,7 +1798,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1802,7 +1806,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -1814,7 +1818,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 91:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -1822,7 +1826,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1830,7 +1834,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1838,7 +1842,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1882,7 +1886,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 186:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1890,7 +1894,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1905,7 +1909,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 115:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -1914,7 +1918,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1928,7 +1932,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1936,7 +1940,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -1948,7 +1952,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 206:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -1957,7 +1961,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1973,7 +1977,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_10
                         }
@@ -1987,7 +1991,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 174:
                 case 46:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_10
                         }
@@ -2004,7 +2008,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 147:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_10
                         }
@@ -2022,7 +2026,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_11
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_10
                         }
@@ -2051,7 +2055,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 126:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2059,7 +2063,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2072,7 +2076,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 219:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2082,7 +2086,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL01_10
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2094,7 +2098,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 125:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL00_12
                             PIXEL10_0
@@ -2111,7 +2115,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 221:
                     {
                         PIXEL00_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL01_11
                             PIXEL11_0
@@ -2126,7 +2130,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 207:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                             PIXEL01_12
@@ -2144,7 +2148,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                             PIXEL11_11
@@ -2159,7 +2163,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 190:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                             PIXEL11_12
@@ -2174,7 +2178,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 187:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                             PIXEL10_11
@@ -2192,7 +2196,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_11
                         PIXEL01_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL10_12
                             PIXEL11_0
@@ -2206,7 +2210,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 119:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL00_11
                             PIXEL01_0
@@ -2225,7 +2229,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2239,7 +2243,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 175:
                 case 47:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2256,7 +2260,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 151:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2274,7 +2278,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_11
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2288,7 +2292,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2296,7 +2300,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2308,7 +2312,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 123:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2317,7 +2321,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2330,7 +2334,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 95:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2338,7 +2342,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2353,7 +2357,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 222:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2362,7 +2366,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2376,7 +2380,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2384,7 +2388,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2398,7 +2402,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2406,7 +2410,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2418,7 +2422,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 235:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2427,7 +2431,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2440,7 +2444,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 111:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2449,7 +2453,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_100
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2462,7 +2466,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 63:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2470,7 +2474,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2484,7 +2488,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 159:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2492,7 +2496,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2507,7 +2511,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 215:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2516,7 +2520,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_100
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2529,7 +2533,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 246:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2538,7 +2542,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2551,7 +2555,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 254:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2559,7 +2563,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2567,7 +2571,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2581,7 +2585,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2589,7 +2593,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2601,7 +2605,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 251:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2610,7 +2614,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2618,7 +2622,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2630,7 +2634,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 239:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2639,7 +2643,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_100
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2652,7 +2656,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 127:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2660,7 +2664,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2668,7 +2672,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2681,7 +2685,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 191:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2689,7 +2693,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2703,7 +2707,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 223:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2711,7 +2715,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2720,7 +2724,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_100
                         }
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2733,7 +2737,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 247:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2742,7 +2746,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_100
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2754,7 +2758,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 255:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_0
                         }
@@ -2762,7 +2766,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_0
                         }
@@ -2770,7 +2774,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_100
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_0
                         }
@@ -2778,7 +2782,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL11_0
                         }
@@ -2790,6 +2794,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
             }
             sp++;
+            yp++;
             dp += 2;
         }
 
@@ -2799,6 +2804,8 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
         dRowP += drb * 2;
         dp = (uint32_t *) dRowP;
     }
+
+    delete[] yuvImage;
 }
 
 HQX_API void HQX_CALLCONV hq2x_32( uint32_t * sp, uint32_t * dp, int Xres, int Yres )
@@ -77,14 +77,17 @@
 
 HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres )
 {
-    int  i, j, k;
+    int  i, j;
     int  prevline, nextline;
+    int  yprevline, ynextline;
     uint32_t  w[10];
+    uint32_t  y[10];
     int dpL = (drb >> 2);
     int spL = (srb >> 2);
     uint8_t *sRowP = (uint8_t *) sp;
     uint8_t *dRowP = (uint8_t *) dp;
-    uint32_t yuv1, yuv2;
+    uint32_t *yuvImage = hqxConvertToYUV(sp, spL, Xres, Yres);
+    uint32_t *yp = yuvImage;
 
     //   +----+----+----+
     //   |    |    |    |
@@ -101,24 +104,35 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
     {
         if (j>0)      prevline = -spL; else prevline = 0;
         if (j<Yres-1) nextline =  spL; else nextline = 0;
+        if (j>0)      yprevline = -Xres; else yprevline = 0;
+        if (j<Yres-1) ynextline =  Xres; else ynextline = 0;
 
         for (i=0; i<Xres; i++)
         {
             w[2] = *(sp + prevline);
             w[5] = *sp;
             w[8] = *(sp + nextline);
+            y[2] = *(yp + yprevline);
+            y[5] = *yp;
+            y[8] = *(yp + ynextline);
 
             if (i>0)
             {
                 w[1] = *(sp + prevline - 1);
                 w[4] = *(sp - 1);
                 w[7] = *(sp + nextline - 1);
+                y[1] = *(yp + yprevline - 1);
+                y[4] = *(yp - 1);
+                y[7] = *(yp + ynextline - 1);
             }
             else
             {
                 w[1] = w[2];
                 w[4] = w[5];
                 w[7] = w[8];
+                y[1] = y[2];
+                y[4] = y[5];
+                y[7] = y[8];
             }
 
             if (i<Xres-1)
@@ -126,31 +140,21 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 w[3] = *(sp + prevline + 1);
                 w[6] = *(sp + 1);
                 w[9] = *(sp + nextline + 1);
+                y[3] = *(yp + yprevline + 1);
+                y[6] = *(yp + 1);
+                y[9] = *(yp + ynextline + 1);
             }
             else
             {
                 w[3] = w[2];
                 w[6] = w[5];
                 w[9] = w[8];
+                y[3] = y[2];
+                y[6] = y[5];
+                y[9] = y[8];
             }
 
-            int pattern = 0;
-            int flag = 1;
-
-            yuv1 = rgb_to_yuv(w[5]);
-
-            for (k=1; k<=9; k++)
-            {
-                if (k==5) continue;
-
-                if ( w[k] != w[5] )
-                {
-                    yuv2 = rgb_to_yuv(w[k]);
-                    if (yuv_diff(yuv1, yuv2))
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }
+            int pattern = hqx_pattern(y);
 
             switch (pattern)
             {
@@ -378,7 +382,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 50:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_1M
@@ -406,7 +410,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -428,7 +432,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_2
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_1M
@@ -446,7 +450,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 10:
                 case 138:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -556,7 +560,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 54:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -584,7 +588,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -606,7 +610,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_2
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -624,7 +628,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 11:
                 case 139:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -647,7 +651,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 19:
                 case 51:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -671,7 +675,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 146:
                 case 178:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_1M
@@ -695,7 +699,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 84:
                 case 85:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -719,7 +723,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 112:
                 case 113:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -743,7 +747,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 200:
                 case 204:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_1M
@@ -767,7 +771,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 73:
                 case 77:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -791,7 +795,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 42:
                 case 170:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -815,7 +819,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 14:
                 case 142:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -943,7 +947,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 26:
                 case 31:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -954,7 +958,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -974,7 +978,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 214:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -988,7 +992,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -1007,7 +1011,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL01_1
                         PIXEL02_1M
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1018,7 +1022,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -1033,7 +1037,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 74:
                 case 107:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1047,7 +1051,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -1062,7 +1066,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 27:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1085,7 +1089,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 86:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1112,7 +1116,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1133,7 +1137,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1151,7 +1155,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 30:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1178,7 +1182,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1199,7 +1203,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1216,7 +1220,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 75:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1394,7 +1398,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 58:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1403,7 +1407,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1423,7 +1427,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1436,7 +1440,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1M
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1454,7 +1458,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1463,7 +1467,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1475,7 +1479,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 202:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1488,7 +1492,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1502,7 +1506,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 78:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1515,7 +1519,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1529,7 +1533,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 154:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1538,7 +1542,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1558,7 +1562,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1M
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1571,7 +1575,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1589,7 +1593,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1598,7 +1602,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1610,7 +1614,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 90:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1619,7 +1623,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1630,7 +1634,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1639,7 +1643,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1652,7 +1656,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 55:
                 case 23:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -1676,7 +1680,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 182:
                 case 150:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1700,7 +1704,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 213:
                 case 212:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -1724,7 +1728,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 241:
                 case 240:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -1748,7 +1752,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 236:
                 case 232:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1772,7 +1776,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 109:
                 case 105:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -1796,7 +1800,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 171:
                 case 43:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1820,7 +1824,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 143:
                 case 15:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1848,7 +1852,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1U
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1865,7 +1869,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 203:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1888,7 +1892,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 62:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1915,7 +1919,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1932,7 +1936,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 118:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1959,7 +1963,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1980,7 +1984,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1R
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1997,7 +2001,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 155:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2128,7 +2132,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1U
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2136,7 +2140,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL20_2
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2152,7 +2156,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 158:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2160,7 +2164,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_2
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2181,7 +2185,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 234:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2193,7 +2197,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2212,7 +2216,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1M
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2223,7 +2227,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1L
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2239,7 +2243,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 59:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2251,7 +2255,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2273,7 +2277,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2285,7 +2289,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                             PIXEL21_3
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2298,7 +2302,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 87:
                     {
                         PIXEL00_1L
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2314,7 +2318,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL20_1M
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2326,7 +2330,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 79:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2341,7 +2345,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1R
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2355,7 +2359,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 122:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2364,7 +2368,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2374,7 +2378,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2386,7 +2390,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                             PIXEL21_3
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2398,7 +2402,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 94:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2406,7 +2410,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_2
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2420,7 +2424,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2429,7 +2433,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2441,7 +2445,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 218:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2450,7 +2454,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2460,7 +2464,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2468,7 +2472,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL20_2
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2484,7 +2488,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 91:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2496,7 +2500,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2506,7 +2510,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2515,7 +2519,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2579,7 +2583,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 186:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2588,7 +2592,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2608,7 +2612,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2621,7 +2625,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2639,7 +2643,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2648,7 +2652,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2660,7 +2664,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 206:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2673,7 +2677,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2694,7 +2698,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2709,7 +2713,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 174:
                 case 46:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2732,7 +2736,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2759,7 +2763,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2798,7 +2802,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 126:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2811,7 +2815,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL12_3
                         }
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2828,7 +2832,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 219:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2843,7 +2847,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2859,7 +2863,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 125:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -2882,7 +2886,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 221:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -2905,7 +2909,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 207:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2928,7 +2932,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 238:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2951,7 +2955,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 190:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2974,7 +2978,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 187:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2997,7 +3001,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 243:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -3020,7 +3024,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 119:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -3050,7 +3054,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                         }
@@ -3065,7 +3069,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 175:
                 case 47:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                         }
@@ -3088,7 +3092,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                         }
@@ -3115,7 +3119,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_C
                         }
@@ -3131,7 +3135,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL01_C
                         PIXEL02_1M
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3142,7 +3146,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3156,7 +3160,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 123:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3170,7 +3174,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3185,7 +3189,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 95:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3196,7 +3200,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3215,7 +3219,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 222:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3229,7 +3233,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3248,7 +3252,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1U
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3259,7 +3263,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_C
                         }
@@ -3276,7 +3280,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                         }
@@ -3285,7 +3289,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3299,7 +3303,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 235:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3313,7 +3317,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                         }
@@ -3327,7 +3331,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 111:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                         }
@@ -3340,7 +3344,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3355,7 +3359,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 63:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                         }
@@ -3364,7 +3368,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3383,7 +3387,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 159:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3394,7 +3398,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                         }
@@ -3413,7 +3417,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                         }
@@ -3425,7 +3429,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3440,7 +3444,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 246:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3455,7 +3459,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_C
                         }
@@ -3468,7 +3472,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 254:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3479,7 +3483,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL02_4
                         }
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3489,7 +3493,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                             PIXEL20_4
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -3511,7 +3515,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                         }
@@ -3520,7 +3524,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_C
                         }
@@ -3532,7 +3536,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 251:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3544,7 +3548,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL02_1M
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3556,7 +3560,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                             PIXEL21_3
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3570,7 +3574,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 239:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                         }
@@ -3583,7 +3587,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                         }
@@ -3597,7 +3601,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 127:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3609,7 +3613,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3620,7 +3624,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL12_3
                         }
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3635,7 +3639,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 191:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                         }
@@ -3644,7 +3648,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                         }
@@ -3662,7 +3666,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 223:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3672,7 +3676,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_4
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3686,7 +3690,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3702,7 +3706,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                         }
@@ -3715,7 +3719,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_C
                         }
@@ -3727,7 +3731,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 255:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(y[4], y[2]))
                         {
                             PIXEL00_C
                         }
@@ -3736,7 +3740,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(y[2], y[6]))
                         {
                             PIXEL02_C
                         }
@@ -3747,7 +3751,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(y[8], y[4]))
                         {
                             PIXEL20_C
                         }
@@ -3756,7 +3760,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(y[6], y[8]))
                         {
                             PIXEL22_C
                         }
@@ -3768,6 +3772,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
             }
             sp++;
+            yp++;
             dp += 3;
         }
 
@@ -3777,6 +3782,8 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
         dRowP += drb * 3;
         dp = (uint32_t *) dRowP;
     }
+
+    delete[] yuvImage;
 }
 
 HQX_API void HQX_CALLCONV hq3x_32( uint32_t * sp, uint32_t * dp, int Xres, int Yres )
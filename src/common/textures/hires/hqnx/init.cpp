@@ -17,6 +17,7 @@
  */
 
 #include "hqx.h"
+#include "common.h"
 
 uint32_t   *RGBtoYUV;
 uint32_t   YUV1, YUV2;
@@ -36,3 +37,18 @@ HQX_API void HQX_CALLCONV hqxInit(void)
         RGBtoYUV[c] = (y << 16) + (u << 8) + v;
     }
 }
+
+uint32_t *hqxConvertToYUV(const uint32_t *sp, int spL, int Xres, int Yres)
+{
+    uint32_t *yuv = new uint32_t[Xres * Yres];
+    uint32_t *yp = yuv;
+
+    for (int j = 0; j < Yres; j++, sp += spL)
+    {
+        for (int i = 0; i < Xres; i++)
+        {
+            *yp++ = rgb_to_yuv(sp[i]);
+        }
+    }
+    return yuv;
+}
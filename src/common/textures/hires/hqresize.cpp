@@ -40,12 +40,21 @@
 #include "hqnx_asm/hqnx_asm.h"
 #endif
 #include <memory>
+#include <future>
+#include <thread>
 #include "xbr/xbrz.h"
 #include "xbr/xbrz_old.h"
 #include "parallel_for.h"
 #include "textures.h"
 #include "texturemanager.h"
 #include "printf.h"
+#include "m_crc32.h"
+#include "cmdlib.h"
+#include "i_specialpaths.h"
+#include "files.h"
+#include "ctpl.h"
+#include "c_dispatch.h"
+#include "stats.h"
 
 int upscalemask;
 
@@ -103,6 +112,9 @@ CUSTOM_CVAR(Int, gl_texture_hqresize_mt_height, 4, CVAR_ARCHIVE | CVAR_GLOBALCON
 
 CVAR(Int, xbrz_colorformat, 0, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 
+CVAR(Bool, gl_texture_hqresize_precache, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)	// upscale precached textures on worker threads
+CVAR(Bool, gl_texture_hqresize_diskcache, false, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)	// keep upscaled textures in the cache directory
+
 void UpdateUpscaleMask()
 {
 	if (!gl_texture_hqresizemode || gl_texture_hqresizemult == 1) upscalemask = 0;
@@ -286,6 +298,17 @@ static unsigned char *normalNx(const int N,
 }
 
 #ifdef HAVE_MMX
+static void hqNxAsmInitOnce()
+{
+	static bool initdone = false;
+
+	if (!initdone)
+	{
+		HQnX_asm::InitLUTs();
+		initdone = true;
+	}
+}
+
 static unsigned char *hqNxAsmHelper( void (*hqNxFunction) ( int*, unsigned char*, int, int, int ),
 							  const int N,
 							  unsigned char *inputBuffer,
@@ -297,13 +320,7 @@ static unsigned char *hqNxAsmHelper( void (*hqNxFunction) ( int*, unsigned char*
 	outWidth = N * inWidth;
 	outHeight = N *inHeight;
 
-	static int initdone = false;
-
-	if (!initdone)
-	{
-		HQnX_asm::InitLUTs();
-		initdone = true;
-	}
+	hqNxAsmInitOnce();
 
 	auto pImageIn = std::make_unique<HQnX_asm::CImage>();
 	auto& cImageIn = *pImageIn;
@@ -317,6 +334,17 @@ static unsigned char *hqNxAsmHelper( void (*hqNxFunction) ( int*, unsigned char*
 }
 #endif
 
+static void hqxInitOnce()
+{
+	static bool initdone = false;
+
+	if (!initdone)
+	{
+		hqxInit();
+		initdone = true;
+	}
+}
+
 static unsigned char *hqNxHelper( void (HQX_CALLCONV *hqNxFunction) ( unsigned*, unsigned*, int, int ),
 							  const int N,
 							  unsigned char *inputBuffer,
@@ -325,13 +353,7 @@ static unsigned char *hqNxHelper( void (HQX_CALLCONV *hqNxFunction) ( unsigned*,
 							  int &outWidth,
 							  int &outHeight )
 {
-	static int initdone = false;
-
-	if (!initdone)
-	{
-		hqxInit();
-		initdone = true;
-	}
+	hqxInitOnce();
 	outWidth = N * inWidth;
 	outHeight = N *inHeight;
 
@@ -416,21 +438,15 @@ static void xbrzOldScale(size_t factor, const uint32_t* src, uint32_t* trg, int
 
 //===========================================================================
 // 
-// [BB] Upsamples the texture in texbuffer.mBuffer, frees texbuffer.mBuffer and returns
-//  the upsampled buffer.
+// Resolves the scaler and factor to use. Returns false if the current
+// settings do not upscale anything.
 //
 //===========================================================================
 
-void FTexture::CreateUpsampledTextureBuffer(FTextureBuffer &texbuffer, bool hasAlpha, bool checkonly)
+static bool GetUpscaleMode(bool hasAlpha, int &type, int &mult)
 {
-	// [BB] Make sure that inWidth and inHeight denote the size of
-	// the returned buffer even if we don't upsample the input buffer.
-
-	int inWidth = texbuffer.mWidth;
-	int inHeight = texbuffer.mHeight;
-
-	int type = gl_texture_hqresizemode;
-	int mult = gl_texture_hqresizemult;
+	type = gl_texture_hqresizemode;
+	mult = gl_texture_hqresizemult;
 #ifdef HAVE_MMX
 	// hqNx MMX does not preserve the alpha channel so fall back to C-version for such textures
 	if (hasAlpha && type == 3)
@@ -439,51 +455,316 @@ void FTexture::CreateUpsampledTextureBuffer(FTextureBuffer &texbuffer, bool hasA
 	}
 #endif
 	// These checks are to ensure consistency of the content ID.
-	if (mult < 2 || mult > 6 || type < 1 || type > 6) return;
+	if (mult < 2 || mult > 6 || type < 1 || type > 6) return false;
 	if (type < 4 && mult > 4) mult = 4;
+	return true;
+}
 
-	if (!checkonly)
+//===========================================================================
+// 
+// Runs the actual scaler. Takes ownership of inputBuffer and returns the 
+// upsampled buffer, or nullptr if the combination is not supported, in
+// which case inputBuffer is left alone.
+//
+//===========================================================================
+
+static unsigned char *UpscaleBuffer(int type, int mult, unsigned char *inputBuffer, int inWidth, int inHeight, int &outWidth, int &outHeight)
+{
+	if (type == 1)
+	{
+		if (mult == 2)
+			return scaleNxHelper(&scale2x, 2, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+		else if (mult == 3)
+			return scaleNxHelper(&scale3x, 3, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+		else if (mult == 4)
+			return scaleNxHelper(&scale4x, 4, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+	}
+	else if (type == 2)
+	{
+		if (mult == 2)
+			return hqNxHelper(&hq2x_32, 2, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+		else if (mult == 3)
+			return hqNxHelper(&hq3x_32, 3, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+		else if (mult == 4)
+			return hqNxHelper(&hq4x_32, 4, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+	}
+#ifdef HAVE_MMX
+	else if (type == 3)
+	{
+		if (mult == 2)
+			return hqNxAsmHelper(&HQnX_asm::hq2x_32, 2, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+		else if (mult == 3)
+			return hqNxAsmHelper(&HQnX_asm::hq3x_32, 3, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+		else if (mult == 4)
+			return hqNxAsmHelper(&HQnX_asm::hq4x_32, 4, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+	}
+#endif
+	else if (type == 4)
+		return xbrzHelper(xbrz::scale, mult, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+	else if (type == 5)
+		return xbrzHelper(xbrzOldScale, mult, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+	else if (type == 6)
+		return normalNx(mult, inputBuffer, inWidth, inHeight, outWidth, outHeight);
+
+	return nullptr;
+}
+
+//===========================================================================
+// 
+// Upscale cache
+//
+// Upscaled images are looked up by a hash of the source pixels and the
+// scaler settings. During precaching all needed images get queued for
+// upscaling on worker threads, so that uploading them only has to pick up
+// the results. Optionally the results are also stored on disk so that
+// later runs do not have to upscale them again.
+//
+//===========================================================================
+
+struct FUpscaleJob
+{
+	std::future<void> Done;
+	unsigned char *Buffer = nullptr;
+	int Width = 0;
+	int Height = 0;
+};
+
+static TMap<FString, FUpscaleJob *> UpscaleJobs;	// only accessed by the main thread.
+static std::unique_ptr<ctpl::thread_pool> UpscalePool;
+static const uint32_t UPSCALE_CACHE_MAGIC = MAKE_ID('U', 'P', 'S', '1');
+
+static FString UpscaleCacheKey(const unsigned char *buffer, int width, int height, int type, int mult)
+{
+	const unsigned size = width * height * 4;
+	uint32_t cfgcrc = 0;
+
+	if (type == 4 || type == 5)
+	{
+		const float cfg[] = { xbrz_luminanceweight, xbrz_equalcolortolerance, xbrz_centerdirectionbias, xbrz_dominantdirectionthreshold, xbrz_steepdirectionthreshold };
+		const int unbuffered = xbrz_colorformat != 0;	// the color format changes the scaled result, too.
+		cfgcrc = CalcCRC32((const uint8_t *)cfg, sizeof(cfg));
+		cfgcrc = AddCRC32(cfgcrc, (const uint8_t *)&unbuffered, sizeof(unbuffered));
+	}
+	// Two different checksums over the pixels to make collisions in the disk cache practically impossible.
+	return FStringf("%08x%08x-%dx%d-%d-%d-%08x", CalcCRC32(buffer, size), (uint32_t)adler32(1, buffer, size), width, height, type, mult, cfgcrc);
+}
+
+static FString UpscaleCachePath(const FString &key)
+{
+	static FString cachedir;
+
+	if (cachedir.IsEmpty())
+	{
+		cachedir = M_GetCachePath(true);
+		cachedir += "/upscale/";
+		CreatePath(cachedir.GetChars());
+	}
+	return cachedir + key + ".bin";
+}
+
+static unsigned char *ReadUpscaleCache(const char *path, int &width, int &height)
+{
+	FileReader fr;
+	uint32_t header[4];
+
+	if (!fr.OpenFile(path)) return nullptr;
+	if (fr.Read(header, sizeof(header)) != sizeof(header) || header[0] != UPSCALE_CACHE_MAGIC) return nullptr;
+
+	width = header[1];
+	height = header[2];
+	uLong packedsize = header[3];
+	uLong size = uLong(width) * height * 4;
+
+	TArray<uint8_t> packed(packedsize, true);
+	if (fr.Read(packed.Data(), packedsize) != (ptrdiff_t)packedsize) return nullptr;
+
+	auto buffer = new unsigned char[size];
+	uLong unpackedsize = size;
+	if (uncompress(buffer, &unpackedsize, packed.Data(), packedsize) != Z_OK || unpackedsize != size)
+	{
+		delete[] buffer;
+		return nullptr;
+	}
+	return buffer;
+}
+
+static void WriteUpscaleCache(const char *path, const unsigned char *buffer, int width, int height)
+{
+	uLong size = uLong(width) * height * 4;
+	uLong packedsize = compressBound(size);
+	TArray<uint8_t> packed(packedsize, true);
+
+	if (compress2(packed.Data(), &packedsize, buffer, size, Z_BEST_SPEED) != Z_OK) return;
+
+	std::unique_ptr<FileWriter> fw(FileWriter::Open(path));
+	if (fw == nullptr) return;
+
+	uint32_t header[4] = { UPSCALE_CACHE_MAGIC, uint32_t(width), uint32_t(height), uint32_t(packedsize) };
+	fw->Write(header, sizeof(header));
+	fw->Write(packed.Data(), packedsize);
+}
+
+// Replaces the buffer's contents with an already upscaled image if one is available.
+static bool FindUpscaledBuffer(const FString &key, FTextureBuffer &texbuffer)
+{
+	unsigned char *buffer = nullptr;
+	int width = 0, height = 0;
+
+	auto pjob = UpscaleJobs.CheckKey(key);
+	if (pjob != nullptr)
+	{
+		auto job = *pjob;
+		UpscaleJobs.Remove(key);
+		job->Done.wait();
+		buffer = job->Buffer;
+		width = job->Width;
+		height = job->Height;
+		delete job;
+	}
+	else if (gl_texture_hqresize_diskcache)
+	{
+		buffer = ReadUpscaleCache(UpscaleCachePath(key).GetChars(), width, height);
+	}
+
+	if (buffer == nullptr) return false;
+
+	if (texbuffer.mFreeBuffer) delete[] texbuffer.mBuffer;
+	texbuffer.mBuffer = buffer;
+	texbuffer.mFreeBuffer = true;
+	texbuffer.mWidth = width;
+	texbuffer.mHeight = height;
+	return true;
+}
+
+//===========================================================================
+// 
+// Creates this texture's source image and starts upscaling it on a worker
+// thread. Only meant to be called while precaching, before the texture is
+// actually needed.
+//
+//===========================================================================
+
+void FTexture::QueueUpscale(int flags)
+{
+	int type, mult;
+
+	if (!gl_texture_hqresize_precache || !(flags & CTF_Upscale) || GetImage() == nullptr) return;
+
+	auto input = CreateTexBuffer(0, flags & CTF_Expand);
+	if (input.mBuffer == nullptr || !GetUpscaleMode(!!bTranslucent, type, mult)) return;
+
+	FString key = UpscaleCacheKey(input.mBuffer, input.mWidth, input.mHeight, type, mult);
+	if (UpscaleJobs.CheckKey(key) != nullptr) return;
+
+	// FString's reference counting is not thread safe, so the worker gets its own copy of the path.
+	std::string cachepath;
+	if (gl_texture_hqresize_diskcache)
+	{
+		FString path = UpscaleCachePath(key);
+		if (FileExists(path)) return;	// the disk cache is fast enough to read when needed.
+		cachepath = path.GetChars();
+	}
+
+	// The job needs to own the source buffer.
+	unsigned char *source = input.mBuffer;
+	if (input.mFreeBuffer)
+	{
+		input.mBuffer = nullptr;
+	}
+	else
+	{
+		size_t size = size_t(input.mWidth) * input.mHeight * 4;
+		source = new unsigned char[size];
+		memcpy(source, input.mBuffer, size);
+	}
+
+	// The hqNx lookup tables must not be initialized from several worker threads at once.
+	if (type == 2) hqxInitOnce();
+#ifdef HAVE_MMX
+	if (type == 3) hqNxAsmInitOnce();
+#endif
+
+	if (UpscalePool == nullptr)
+	{
+		UpscalePool.reset(new ctpl::thread_pool(max(1, (int)std::thread::hardware_concurrency() - 1)));
+	}
+
+	auto job = new FUpscaleJob;
+	int width = input.mWidth, height = input.mHeight;
+	job->Done = UpscalePool->push([=](int)
 	{
-		if (type == 1)
+		job->Buffer = UpscaleBuffer(type, mult, source, width, height, job->Width, job->Height);
+		if (job->Buffer == nullptr)
 		{
-			if (mult == 2)
-				texbuffer.mBuffer = scaleNxHelper(&scale2x, 2, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else if (mult == 3)
-				texbuffer.mBuffer = scaleNxHelper(&scale3x, 3, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else if (mult == 4)
-				texbuffer.mBuffer = scaleNxHelper(&scale4x, 4, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else return;
+			delete[] source;
 		}
-		else if (type == 2)
+		else if (!cachepath.empty())
 		{
-			if (mult == 2)
-				texbuffer.mBuffer = hqNxHelper(&hq2x_32, 2, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else if (mult == 3)
-				texbuffer.mBuffer = hqNxHelper(&hq3x_32, 3, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else if (mult == 4)
-				texbuffer.mBuffer = hqNxHelper(&hq4x_32, 4, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else return;
+			WriteUpscaleCache(cachepath.c_str(), job->Buffer, job->Width, job->Height);
 		}
-#ifdef HAVE_MMX
-		else if (type == 3)
+	});
+	UpscaleJobs.Insert(key, job);
+}
+
+//===========================================================================
+// 
+// Waits for all pending upscale jobs and discards the results nobody
+// picked up.
+//
+//===========================================================================
+
+void FlushUpscaleQueue()
+{
+	decltype(UpscaleJobs)::Iterator it(UpscaleJobs);
+	decltype(UpscaleJobs)::Pair *pair;
+
+	while (it.NextPair(pair))
+	{
+		auto job = pair->Value;
+		job->Done.wait();
+		delete[] job->Buffer;
+		delete job;
+	}
+	UpscaleJobs.Clear();
+}
+
+//===========================================================================
+// 
+// [BB] Upsamples the texture in texbuffer.mBuffer, frees texbuffer.mBuffer and returns
+//  the upsampled buffer.
+//
+//===========================================================================
+
+void FTexture::CreateUpsampledTextureBuffer(FTextureBuffer &texbuffer, bool hasAlpha, bool checkonly)
+{
+	// [BB] Make sure that inWidth and inHeight denote the size of
+	// the returned buffer even if we don't upsample the input buffer.
+
+	int inWidth = texbuffer.mWidth;
+	int inHeight = texbuffer.mHeight;
+
+	int type, mult;
+	if (!GetUpscaleMode(hasAlpha, type, mult)) return;
+
+	if (!checkonly)
+	{
+		FString key;
+		if (gl_texture_hqresize_diskcache || UpscaleJobs.CountUsed() > 0)
 		{
-			if (mult == 2)
-				texbuffer.mBuffer = hqNxAsmHelper(&HQnX_asm::hq2x_32, 2, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else if (mult == 3)
-				texbuffer.mBuffer = hqNxAsmHelper(&HQnX_asm::hq3x_32, 3, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else if (mult == 4)
-				texbuffer.mBuffer = hqNxAsmHelper(&HQnX_asm::hq4x_32, 4, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-			else return;
+			key = UpscaleCacheKey(texbuffer.mBuffer, inWidth, inHeight, type, mult);
+		}
+
+		if (key.IsEmpty() || !FindUpscaledBuffer(key, texbuffer))
+		{
+			auto buffer = UpscaleBuffer(type, mult, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
+			if (buffer == nullptr) return;
+			texbuffer.mBuffer = buffer;
+
+			if (gl_texture_hqresize_diskcache)
+			{
+				WriteUpscaleCache(UpscaleCachePath(key).GetChars(), texbuffer.mBuffer, texbuffer.mWidth, texbuffer.mHeight);
+			}
 		}
-#endif
-		else if (type == 4)
-			texbuffer.mBuffer = xbrzHelper(xbrz::scale, mult, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-		else if (type == 5)
-			texbuffer.mBuffer = xbrzHelper(xbrzOldScale, mult, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-		else if (type == 6)
-			texbuffer.mBuffer = normalNx(mult, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
-		else
-			return;
 	}
 	else
 	{
@@ -522,4 +803,72 @@ void calcShouldUpscale(FGameTexture *tex)
 		return;
 
 	tex->SetUpscaleFlag(1);
-}
\ No newline at end of file
+}
+
+//===========================================================================
+// 
+// Benchmarks all scalers over the loaded wall textures.
+// Usage: bench_upscale [max number of textures]
+//
+//===========================================================================
+
+CCMD(bench_upscale)
+{
+	static const char *const scalernames[] = { "", "scaleNx", "hqNx", "hqNx MMX", "xBRZ", "xBRZ (old)", "normalNx" };
+	TArray<FTextureBuffer> corpus;
+	int maxcount = argv.argc() > 1 ? (int)strtol(argv[1], nullptr, 10) : 100;
+	int64_t pixels = 0;
+
+	for (int i = 1; i < TexMan.NumTextures() && (int)corpus.Size() < maxcount; i++)
+	{
+		auto gtex = TexMan.GameByIndex(i);
+		if (gtex == nullptr || !gtex->isValid() || gtex->GetUseType() != ETextureType::Wall) continue;
+		auto tex = gtex->GetTexture();
+		if (tex == nullptr || tex->GetImage() == nullptr) continue;
+
+		auto buffer = tex->CreateTexBuffer(0);
+		if (buffer.mBuffer == nullptr) continue;
+		pixels += buffer.mWidth * buffer.mHeight;
+		corpus.Push(std::move(buffer));
+	}
+	if (corpus.Size() == 0)
+	{
+		Printf("No wall textures loaded\n");
+		return;
+	}
+	Printf("Upscaling %u textures, %.2f megapixels\n", corpus.Size(), pixels / 1e6);
+
+	for (int type = 1; type <= 6; type++)
+	{
+		for (int mult = 2; mult <= (type < 4 ? 4 : 6); mult++)
+		{
+			cycle_t time;
+			time.Reset();
+			bool supported = true;
+
+			for (auto &tex : corpus)
+			{
+				size_t size = size_t(tex.mWidth) * tex.mHeight * 4;
+				auto source = new unsigned char[size];
+				memcpy(source, tex.mBuffer, size);
+
+				int outWidth, outHeight;
+				time.Clock();
+				auto result = UpscaleBuffer(type, mult, source, tex.mWidth, tex.mHeight, outWidth, outHeight);
+				time.Unclock();
+
+				if (result == nullptr)
+				{
+					delete[] source;
+					supported = false;
+					break;
+				}
+				delete[] result;
+			}
+			if (supported)
+			{
+				Printf("%-10s %dx: %8.2f ms, %7.2f Mpixels/s\n", scalernames[type], mult, time.TimeMS(), pixels / 1e3 / time.TimeMS());
+			}
+		}
+	}
+}
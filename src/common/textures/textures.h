@@ -229,6 +229,7 @@ public:
 	IHardwareTexture* GetHardwareTexture(int translation, int scaleflags);
 	virtual FImageSource *GetImage() const { return nullptr; }
 	void CreateUpsampledTextureBuffer(FTextureBuffer &texbuffer, bool hasAlpha, bool checkonly);
+	void QueueUpscale(int flags);
 
 	void CleanHardwareTextures()
 	{
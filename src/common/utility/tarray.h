@@ -56,6 +56,7 @@
 #include <iterator>
 #include <algorithm>
 #include <functional>
+#include <type_traits>
 
 #if !defined(_WIN32)
 #include <inttypes.h>		// for intptr_t
@@ -1063,41 +1064,25 @@ public:
 
 // TMap ---------------------------------------------------------------------
 // An associative array, similar in concept to the STL extension
-// class hash_map. It is implemented using Lua's table algorithm:
-/*
-** Hash uses a mix of chained scatter table with Brent's variation.
-** A main invariant of these tables is that, if an element is not
-** in its main position (i.e. the `original' position that its hash gives
-** to it), then the colliding element is in its own main position.
-** Hence even when the load factor reaches 100%, performance remains good.
-*/
-/******************************************************************************
-* Copyright (C) 1994-2006 Lua.org, PUC-Rio.  All rights reserved.
-*
-* Permission is hereby granted, free of charge, to any person obtaining
-* a copy of this software and associated documentation files (the
-* "Software"), to deal in the Software without restriction, including
-* without limitation the rights to use, copy, modify, merge, publish,
-* distribute, sublicense, and/or sell copies of the Software, and to
-* permit persons to whom the Software is furnished to do so, subject to
-* the following conditions:
-*
-* The above copyright notice and this permission notice shall be
-* included in all copies or substantial portions of the Software.
-*
-* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
-* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
-* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
-* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
-* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
-* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
-* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
-******************************************************************************/
+// class hash_map. It is an open addressing table with linear probing:
+// all pairs are stored in a single array, next to a byte per slot that
+// marks it as empty, deleted or used, with a part of the key's hash for
+// the latter. Lookups therefore touch one contiguous run of memory and
+// compare keys only when the stored hash bits match.
 
 typedef unsigned int hash_t;
 
+template<class Traits, class = void> struct THashScramble { static constexpr bool Value = false; };
+template<class Traits> struct THashScramble<Traits, std::void_t<decltype(Traits::Scramble)>> { static constexpr bool Value = Traits::Scramble; };
+
 template<class KT> struct THashTraits
 {
+	// Integer keys are placed by their value, so maps of small or dense
+	// keys keep iterating in ascending order. Pointers have their low bits
+	// clear and get scrambled before they pick a slot. Traits for other
+	// low-entropy keys can opt into this by defining Scramble as well.
+	static constexpr bool Scramble = std::is_pointer<KT>::value;
+
 	// Returns the hash value for a key.
 	hash_t Hash(const KT key) { return (hash_t)(intptr_t)key; }
 	hash_t Hash(double key)
@@ -1149,9 +1134,10 @@ template<class VT> struct TValueTraits
 struct FMap
 {
 	void *Nodes;
-	void *LastFree;
+	void *Ctrl;
 	hash_t Size;
 	hash_t NumUsed;
+	hash_t NumDeleted;
 };
 
 
@@ -1182,15 +1168,16 @@ public:
 	{
 		NumUsed = 0;
 		SetNodeVector(o.CountUsed());
-		CopyNodes(o.Nodes, o.Size);
+		CopyNodes(o);
 	}
 
 	TMap(TMap &&o)
 	{
 		Nodes = o.Nodes;
-		LastFree = o.LastFree;		/* any free position is before this position */
+		Ctrl = o.Ctrl;
 		Size = o.Size;		/* must be a power of 2 */
 		NumUsed = o.NumUsed;
+		NumDeleted = o.NumDeleted;
 
 		o.Size = 0;
 		o.NumUsed = 0;
@@ -1199,10 +1186,13 @@ public:
 
 	TMap &operator= (const TMap &o)
 	{
-		NumUsed = 0;
-		ClearNodeVector();
-		SetNodeVector(o.CountUsed());
-		CopyNodes(o.Nodes, o.Size);
+		if (&o != this)
+		{
+			NumUsed = 0;
+			ClearNodeVector();
+			SetNodeVector(o.CountUsed());
+			CopyNodes(o);
+		}
 		return *this;
 	}
 
@@ -1229,17 +1219,19 @@ public:
 
 		// Copy all of o's nodes.
 		Nodes = o.Nodes;
-		LastFree = o.LastFree;
+		Ctrl = o.Ctrl;
 		Size = o.Size;
 		NumUsed = o.NumUsed;
+		NumDeleted = o.NumDeleted;
 
 		// Tell o it doesn't have any nodes.
 		o.Nodes = NULL;
+		o.Ctrl = NULL;
 		o.Size = 0;
-		o.LastFree = NULL;
 		o.NumUsed = 0;
+		o.NumDeleted = 0;
 
-		// Leave o functional with one empty node.
+		// Leave o functional with an empty table.
 		o.SetNodeVector(1);
 	}
 
@@ -1269,10 +1261,9 @@ public:
 	{
 #ifdef _DEBUG
 		hash_t used = 0;
-		hash_t ct = Size;
-		for (Node *n = Nodes; ct-- > 0; ++n)
+		for (hash_t i = 0; i < Size; ++i)
 		{
-			if (!n->IsNil())
+			if (IsFull(i))
 			{
 				++used;
 			}
@@ -1385,6 +1376,8 @@ public:
 	// Remove
 	//
 	// Removes the key/value pair for a particular key if it is in the table.
+	// No other entry is moved by this, so it is safe to remove the pair
+	// an iterator has just returned.
 	//
 	//=======================================================================
 
@@ -1396,9 +1389,46 @@ public:
 	void Swap(MyType &other)
 	{
 		std::swap(Nodes, other.Nodes);
-		std::swap(LastFree, other.LastFree);
+		std::swap(Ctrl, other.Ctrl);
 		std::swap(Size, other.Size);
 		std::swap(NumUsed, other.NumUsed);
+		std::swap(NumDeleted, other.NumDeleted);
+	}
+
+	//=======================================================================
+	//
+	// NextPair
+	//
+	// Steps a caller-owned position to the next pair in the table. This is
+	// what the iterator classes use; it is exposed for iterators that need
+	// to be stored without a reference to the map, like the script ones.
+	//
+	//=======================================================================
+
+	bool NextPair(hash_t &position, Pair *&pair)
+	{
+		for (; position < Size; ++position)
+		{
+			if (IsFull(position))
+			{
+				pair = reinterpret_cast<Pair *>(&Nodes[position++].Pair);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool NextPair(hash_t &position, ConstPair *&pair) const
+	{
+		for (; position < Size; ++position)
+		{
+			if (IsFull(position))
+			{
+				pair = reinterpret_cast<ConstPair *>(&Nodes[position++].Pair);
+				return true;
+			}
+		}
+		return false;
 	}
 
 protected:
@@ -1409,16 +1439,15 @@ protected:
 	};
 	struct Node
 	{
-		Node *Next;
 		IPair Pair;
-		void SetNil()
-		{
-			Next = (Node *)1;
-		}
-		bool IsNil() const
-		{
-			return Next == (Node *)1;
-		}
+	};
+
+	/* Control bytes. A used slot stores 7 bits of its key's hash, so most
+	 * mismatches are rejected without looking at the key itself. */
+	enum : uint8_t
+	{
+		CTRL_EMPTY = 0x80,
+		CTRL_DELETED = 0xFE,
 	};
 
 	/* This is used instead of memcpy, because Node is likely to be small,
@@ -1427,66 +1456,89 @@ protected:
 	struct NodeSizedStruct { unsigned char Pads[sizeof(Node)]; };
 
 	Node *Nodes;
-	Node *LastFree;		/* any free position is before this position */
+	uint8_t *Ctrl;		/* one byte per node, stored right after the nodes */
 	hash_t Size;		/* must be a power of 2 */
 	hash_t NumUsed;
+	hash_t NumDeleted;	/* slots that must not stop a probe but hold no pair */
 
-	const Node *MainPosition(const KT k) const
+	bool IsFull(hash_t i) const
 	{
-		HashTraits Traits;
-		return &Nodes[Traits.Hash(k) & (Size - 1)];
+		return !(Ctrl[i] & CTRL_EMPTY);
 	}
 
-	Node *MainPosition(const KT k)
+	/* The lower half of the result picks the slot: the hash itself, unless
+	 * the traits ask for it to be scrambled. The tag in the control byte
+	 * always comes from the top 7 bits of the scrambled hash, because
+	 * keys that hash to themselves rarely have those bits set. */
+	static uint64_t Scramble(const KT k)
 	{
 		HashTraits Traits;
-		return &Nodes[Traits.Hash(k) & (Size - 1)];
+		hash_t hash = Traits.Hash(k);
+		uint64_t mixed = uint64_t(hash) * 0x9E3779B97F4A7C15ull;
+		return (mixed & ~0xffffffffull) | (THashScramble<HashTraits>::Value ? hash_t(mixed >> 32) : hash);
 	}
 
-	void SetNodeVector(hash_t size)
+	hash_t MainPosition(uint64_t h) const
 	{
-		// Round size up to nearest power of 2
-		for (Size = 1; Size < size; Size <<= 1)
+		return hash_t(h) & (Size - 1);
+	}
+
+	static uint8_t Tag(uint64_t h)
+	{
+		return uint8_t(h >> 57);
+	}
+
+	void SetNodeVector(hash_t count)
+	{
+		// Round size up to the nearest power of 2 that holds count entries
+		// without going over the maximum load of 7/8.
+		hash_t size;
+		for (size = 1; size * 7 < count * 8; size <<= 1)
 		{ }
-		Nodes = (Node *)M_Malloc(Size * sizeof(Node));
-		LastFree = &Nodes[Size];	/* all positions are free */
-		for (hash_t i = 0; i < Size; ++i)
-		{
-			Nodes[i].SetNil();
-		}
+		AllocNodes(size);
+	}
+
+	void AllocNodes(hash_t size)
+	{
+		Size = size;
+		Nodes = (Node *)M_Malloc(Size * sizeof(Node) + Size);
+		Ctrl = (uint8_t *)(Nodes + Size);
+		memset(Ctrl, CTRL_EMPTY, Size);
+		NumDeleted = 0;
 	}
 
 	void ClearNodeVector()
 	{
 		for (hash_t i = 0; i < Size; ++i)
 		{
-			if (!Nodes[i].IsNil())
+			if (IsFull(i))
 			{
 				Nodes[i].~Node();
 			}
 		}
 		M_Free(Nodes);
 		Nodes = NULL;
+		Ctrl = NULL;
 		Size = 0;
-		LastFree = NULL;
 		NumUsed = 0;
+		NumDeleted = 0;
 	}
 
 	void Resize(hash_t nhsize)
 	{
 		hash_t i, oldhsize = Size;
 		Node *nold = Nodes;
+		uint8_t *cold = Ctrl;
 		/* create new hash part with appropriate size */
-		SetNodeVector(nhsize);
-		/* re-insert elements from hash part */
-		NumUsed = 0;
+		AllocNodes(nhsize);
+		/* move elements from the old table; their order within a probe
+		** sequence does not matter, so they can be relocated as they are */
 		for (i = 0; i < oldhsize; ++i)
 		{
-			if (!nold[i].IsNil())
+			if (!(cold[i] & CTRL_EMPTY))
 			{
-				Node *n = NewKey(nold[i].Pair.Key);
-				::new(&n->Pair.Value) VT(std::move(nold[i].Pair.Value));
-				nold[i].~Node();
+				uint64_t h = Scramble(nold[i].Pair.Key);
+				CopyNode(&Nodes[FreeSlot(h)], &nold[i]);
 			}
 		}
 		M_Free(nold);
@@ -1494,64 +1546,41 @@ protected:
 
 	void Rehash()
 	{
-		Resize (Size << 1);
+		// If deleted slots are what filled the table, reclaim them without growing.
+		Resize((NumUsed + 1) * 16 <= Size * 7 ? Size : Size << 1);
 	}
 
-	Node *GetFreePos()
+	/* Claims the first empty or deleted slot in the probe sequence for h. */
+	hash_t FreeSlot(uint64_t h)
 	{
-		while (LastFree-- > Nodes)
+		hash_t mask = Size - 1;
+		hash_t i = MainPosition(h);
+		while (IsFull(i))
 		{
-			if (LastFree->IsNil())
-			{
-				return LastFree;
-			}
+			i = (i + 1) & mask;
+		}
+		if (Ctrl[i] == CTRL_DELETED)
+		{
+			--NumDeleted;
 		}
-		return NULL;	/* could not find a free place */
+		Ctrl[i] = Tag(h);
+		return i;
 	}
 
 	/*
-	** Inserts a new key into a hash table; first, check whether key's main 
-	** position is free. If not, check whether colliding node is in its main 
-	** position or not: if it is not, move colliding node to an empty place and 
-	** put new key in its main position; otherwise (colliding node is in its main 
-	** position), new key goes to an empty position. 
+	** Inserts a new key into the table. The caller must have checked that
+	** the key is not already present. At least one slot is always left
+	** empty, so every probe sequence is guaranteed to end.
 	**
 	** The Value field is left unconstructed.
 	*/
 	Node *NewKey(const KT key)
 	{
-		Node *mp = MainPosition(key);
-		if (!mp->IsNil())
-		{
-			Node *othern;
-			Node *n = GetFreePos();		/* get a free place */
-			if (n == NULL)				/* cannot find a free place? */
-			{
-				Rehash();				/* grow table */
-				return NewKey(key);		/* re-insert key into grown table */
-			}
-			othern = MainPosition(mp->Pair.Key);
-			if (othern != mp)			/* is colliding node out of its main position? */
-			{	/* yes; move colliding node into free position */
-				while (othern->Next != mp)	/* find previous */
-				{
-					othern = othern->Next;
-				}
-				othern->Next = n;		/* redo the chain with 'n' in place of 'mp' */
-				CopyNode(n, mp); /* copy colliding node into free pos. (mp->Next also goes) */
-				mp->Next = NULL;		/* now 'mp' is free */
-			}
-			else						/* colliding node is in its own main position */
-			{							/* new node will go into free position */
-				n->Next = mp->Next;		/* chain new position */
-				mp->Next = n;
-				mp = n;
-			}
-		}
-		else
+		if ((NumUsed + NumDeleted + 1) * 8 > Size * 7)
 		{
-			mp->Next = NULL;
+			Rehash();
 		}
+		Node *mp = &Nodes[FreeSlot(Scramble(key))];
 		++NumUsed;
 		::new(&mp->Pair.Key) KT(key);
 		return mp;
@@ -1559,63 +1588,51 @@ protected:
 
 	void DelKey(const KT key)
 	{
-		Node *mp = MainPosition(key), **mpp;
-		HashTraits Traits;
-
-		if (mp->IsNil())
+		hash_t i = FindIndex(key);
+		if (i != Size)
 		{
-			/* the key is definitely not present, because there is nothing at its main position */
-		}
-		else if (!Traits.Compare(mp->Pair.Key, key)) /* the key is in its main position */
-		{
-			if (mp->Next != NULL)		/* move next node to its main position */
-			{
-				Node *n = mp->Next;
-				mp->~Node();			/* deconstruct old node */
-				CopyNode(mp, n);		/* copy next node */
-				n->SetNil();			/* next node is now nil */
-			}
-			else
+			Nodes[i].~Node();
+			/* if the next slot is empty no probe sequence runs through this one */
+			Ctrl[i] = Ctrl[(i + 1) & (Size - 1)] == CTRL_EMPTY ? CTRL_EMPTY : CTRL_DELETED;
+			if (Ctrl[i] == CTRL_DELETED)
 			{
-				mp->~Node();
-				mp->SetNil();			/* there is no chain, so main position is nil */
+				++NumDeleted;
 			}
 			--NumUsed;
 		}
-		else	/* the key is either not present or not in its main position */
+	}
+
+	/* Returns the slot holding key, or Size if it is not in the table. */
+	hash_t FindIndex(const KT key) const
+	{
+		HashTraits Traits;
+		uint64_t h = Scramble(key);
+		uint8_t tag = Tag(h);
+		hash_t mask = Size - 1;
+		for (hash_t i = MainPosition(h); ; i = (i + 1) & mask)
 		{
-			for (mpp = &mp->Next, mp = *mpp; mp != NULL && Traits.Compare(mp->Pair.Key, key); mpp = &mp->Next, mp = *mpp)
-			{ }							/* look for the key */
-			if (mp != NULL)				/* found it */
+			uint8_t c = Ctrl[i];
+			if (c == tag && !Traits.Compare(Nodes[i].Pair.Key, key))
+			{
+				return i;
+			}
+			if (c == CTRL_EMPTY)
 			{
-				*mpp = mp->Next;		/* rechain so this node is skipped */
-				mp->~Node();
-				mp->SetNil();			/* because this node is now nil */
-				--NumUsed;
+				return Size;
 			}
 		}
 	}
 
 	Node *FindKey(const KT key)
 	{
-		HashTraits Traits;
-		Node *n = MainPosition(key);
-		while (n != NULL && !n->IsNil() && Traits.Compare(n->Pair.Key, key))
-		{
-			n = n->Next;
-		}
-		return n == NULL || n->IsNil() ? NULL : n;
+		hash_t i = FindIndex(key);
+		return i == Size ? NULL : &Nodes[i];
 	}
 
 	const Node *FindKey(const KT key) const
 	{
-		HashTraits Traits;
-		const Node *n = MainPosition(key);
-		while (n != NULL && !n->IsNil() && Traits.Compare(n->Pair.Key, key))
-		{
-			n = n->Next;
-		}
-		return n == NULL || n->IsNil() ? NULL : n;
+		hash_t i = FindIndex(key);
+		return i == Size ? NULL : &Nodes[i];
 	}
 
 	Node *GetNode(const KT key)
@@ -1637,15 +1654,15 @@ protected:
 		*(NodeSizedStruct *)dst = *(const NodeSizedStruct *)src;
 	}
 
-	/* Copy all nodes in the node vector to this table. */
-	void CopyNodes(const Node *nodes, hash_t numnodes)
+	/* Copy all nodes of another table to this table. */
+	void CopyNodes(const TMap &o)
 	{
-		for (; numnodes-- > 0; ++nodes)
+		for (hash_t i = 0; i < o.Size; ++i)
 		{
-			if (!nodes->IsNil())
+			if (o.IsFull(i))
 			{
-				Node *n = NewKey(nodes->Pair.Key);
-				::new(&n->Pair.Value) VT(nodes->Pair.Value);
+				Node *n = NewKey(o.Nodes[i].Pair.Key);
+				::new(&n->Pair.Value) VT(o.Nodes[i].Pair.Value);
 			}
 		}
 	}
@@ -1675,20 +1692,7 @@ public:
 
 	bool NextPair(typename MapType::Pair *&pair)
 	{
-		if (Position >= Map.Size)
-		{
-			return false;
-		}
-		do
-		{
-			if (!Map.Nodes[Position].IsNil())
-			{
-				pair = reinterpret_cast<typename MapType::Pair *>(&Map.Nodes[Position].Pair);
-				Position += 1;
-				return true;
-			}
-		} while (++Position < Map.Size);
-		return false;
+		return Map.NextPair(Position, pair);
 	}
 
 	//=======================================================================
@@ -1723,20 +1727,7 @@ public:
 
 	bool NextPair(typename MapType::ConstPair *&pair)
 	{
-		if (Position >= Map.Size)
-		{
-			return false;
-		}
-		do
-		{
-			if (!Map.Nodes[Position].IsNil())
-			{
-				pair = reinterpret_cast<typename MapType::Pair *>(&Map.Nodes[Position].Pair);
-				Position += 1;
-				return true;
-			}
-		} while (++Position < Map.Size);
-		return false;
+		return Map.NextPair(Position, pair);
 	}
 
 protected:
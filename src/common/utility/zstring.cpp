@@ -36,6 +36,7 @@
 #include <ctype.h>
 #include <string.h>
 #include <new>		// for bad_alloc
+#include <atomic>
 
 #include "zstring.h"
 #include "utf8.h"
@@ -52,6 +53,14 @@ FNullStringData FString::NullString =
 	"\0"
 };
 
+// Number of string buffers allocated or resized so far, for benchmarking.
+static std::atomic<unsigned int> StringAllocations;
+
+unsigned int FString::AllocationCount()
+{
+	return StringAllocations.load(std::memory_order_relaxed);
+}
+
 void FString::AttachToOther (const FString &other)
 {
 	assert (other.Chars != NULL);
@@ -451,9 +460,9 @@ void FString::Remove(size_t index, size_t remlen)
 FString FString::Left (size_t numChars) const
 {
 	size_t len = Len();
-	if (len < numChars)
-	{
-		numChars = len;
+	if (len <= numChars)
+	{ // The whole string can share our buffer.
+		return *this;
 	}
 	return FString (Chars, numChars);
 }
@@ -461,9 +470,9 @@ FString FString::Left (size_t numChars) const
 FString FString::Right (size_t numChars) const
 {
 	size_t len = Len();
-	if (len < numChars)
+	if (len <= numChars)
 	{
-		numChars = len;
+		return *this;
 	}
 	return FString (Chars + len - numChars, numChars);
 }
@@ -479,6 +488,10 @@ FString FString::Mid (size_t pos, size_t numChars) const
 	{
 		numChars = len - pos;
 	}
+	if (numChars == len)
+	{
+		return *this;
+	}
 	return FString (Chars + pos, numChars);
 }
 
@@ -1239,7 +1252,10 @@ void FString::ReallocBuffer (size_t newlen)
 	{
 		if (newlen > Data()->AllocLen)
 		{
-			Chars = (char *)(Data()->Realloc(newlen) + 1);
+			// Grow by at least half so that appending piece by piece
+			// does not need a new block every few characters.
+			size_t grown = Data()->AllocLen + Data()->AllocLen / 2;
+			Chars = (char *)(Data()->Realloc(newlen > grown ? newlen : grown) + 1);
 		}
 		Data()->Len = (unsigned int)newlen;
 	}
@@ -1359,6 +1375,7 @@ FStringData *FStringData::Alloc (size_t strlen)
 	{
 		throw std::bad_alloc();
 	}
+	StringAllocations.fetch_add(1, std::memory_order_relaxed);
 	block->Len = 0;
 	block->AllocLen = (unsigned int)strlen - sizeof(FStringData) - 1;
 	block->RefCount = 1;
@@ -1381,6 +1398,7 @@ FStringData *FStringData::Realloc (size_t newstrlen)
 	{
 		throw std::bad_alloc();
 	}
+	StringAllocations.fetch_add(1, std::memory_order_relaxed);
 	block->AllocLen = (unsigned int)newstrlen - sizeof(FStringData) - 1;
 	return block;
 }
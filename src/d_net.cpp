@@ -163,18 +163,85 @@ CUSTOM_CVAR(Int, net_extratic, 0, CVAR_SERVERINFO | CVAR_NOSAVE)
 	}
 }
 
-#ifdef _DEBUG
-CVAR(Int, net_fakelatency, 0, 0);
+// Network condition simulation, so that netplay can be tested on a LAN or
+// with several instances on one machine (-host/-join 127.0.0.1 with -port).
+// net_fakelatency is the round trip time in ms, half of it is added to each
+// direction. net_fakejitter adds a random extra delay of up to that many ms
+// to every packet, which also reorders them. net_fakeloss drops the given
+// percentage of outgoing packets, forcing the retransmit path.
+CVAR(Int, net_fakelatency, 0, CVAR_NOSAVE);
+CVAR(Int, net_fakejitter, 0, CVAR_NOSAVE);
+CVAR(Int, net_fakeloss, 0, CVAR_NOSAVE);
 
 struct PacketStore
 {
-	int timer;
+	uint64_t timer;
 	doomcom_t message;
 };
 
 static TArray<PacketStore> InBuffer;
 static TArray<PacketStore> OutBuffer;
-#endif
+
+// Lockstep statistics for stat net
+static struct NetLockstepStats
+{
+	int Stalls;				// TryRunTics calls that could not run a tic because input was missing
+	int TicsRun;
+	int Dropped;			// packets discarded by net_fakeloss
+	int Depth;				// tics buffered from all nodes at the last TryRunTics
+	int MinDepth, MaxDepth;
+	double DepthSum;
+	int DepthSamples;
+
+	void Clear()
+	{
+		Stalls = TicsRun = Dropped = Depth = 0;
+		MinDepth = INT_MAX;
+		MaxDepth = 0;
+		DepthSum = 0;
+		DepthSamples = 0;
+	}
+
+	void AddDepth(int depth)
+	{
+		Depth = depth;
+		MinDepth = min(MinDepth, depth);
+		MaxDepth = max(MaxDepth, depth);
+		DepthSum += depth;
+		DepthSamples++;
+	}
+} netstats;
+
+static bool NetSimActive()
+{
+	return net_fakelatency > 0 || net_fakejitter > 0 || net_fakeloss > 0;
+}
+
+static uint64_t NetSimDeliveryTime()
+{
+	uint64_t time = I_msTime() + max(0, *net_fakelatency) / 2;
+	if (net_fakejitter > 0)
+	{
+		time += M_Random(net_fakejitter + 1);
+	}
+	return time;
+}
+
+// Returns the due packet with the earliest delivery time, or -1 if none is due yet.
+static int NetSimNextDue(TArray<PacketStore> &buffer)
+{
+	uint64_t now = I_msTime();
+	int best = -1;
+
+	for (unsigned int i = 0; i < buffer.Size(); i++)
+	{
+		if (buffer[i].timer <= now && (best < 0 || buffer[i].timer < buffer[best].timer))
+		{
+			best = i;
+		}
+	}
+	return best;
+}
 
 // [RH] Special "ticcmds" get stored in here
 static struct TicSpecial
@@ -347,6 +414,10 @@ void Net_ClearBuffers ()
 	memset (lastrecvtime, 0, sizeof(lastrecvtime));
 	memset (currrecvtime, 0, sizeof(currrecvtime));
 	memset (consistancy, 0, sizeof(consistancy));
+	I_ClearNetStats ();
+	netstats.Clear ();
+	InBuffer.Clear ();
+	OutBuffer.Clear ();
 	nodeingame[0] = true;
 
 	for (i = 0; i < MAXPLAYERS; i++)
@@ -537,30 +608,30 @@ void HSendPacket (int node, int len)
 	doomcom.remotenode = node;
 	doomcom.datalength = len;
 
-#ifdef _DEBUG
-	if (net_fakelatency / 2 > 0)
+	if (NetSimActive())
 	{
-		PacketStore store;
-		store.message = doomcom;
-		store.timer = I_GetTime() + ((net_fakelatency / 2) / (1000 / TICRATE));
-		OutBuffer.Push(store);
+		if (net_fakeloss > 0 && M_Random(100) < net_fakeloss)
+		{
+			netstats.Dropped++;
+		}
+		else
+		{
+			PacketStore store;
+			store.message = doomcom;
+			store.timer = NetSimDeliveryTime();
+			OutBuffer.Push(store);
+		}
 	}
 	else
 		I_NetCmd();
 
-	for (unsigned int i = 0; i < OutBuffer.Size(); i++)
+	int due;
+	while ((due = NetSimNextDue(OutBuffer)) >= 0)
 	{
-		if (OutBuffer[i].timer <= I_GetTime())
-		{
-			doomcom = OutBuffer[i].message;
-			I_NetCmd();
-			OutBuffer.Delete(i);
-			i = -1;
-		}
+		doomcom = OutBuffer[due].message;
+		I_NetCmd();
+		OutBuffer.Delete(due);
 	}
-#else
-	I_NetCmd();
-#endif
 }
 
 //
@@ -586,38 +657,24 @@ bool HGetPacket (void)
 	doomcom.command = CMD_GET;
 	I_NetCmd ();
 
-#ifdef _DEBUG
-	if (net_fakelatency / 2 > 0 && doomcom.remotenode != -1)
+	if (NetSimActive() && doomcom.remotenode != -1)
 	{
 		PacketStore store;
 		store.message = doomcom;
-		store.timer = I_GetTime() + ((net_fakelatency / 2) / (1000 / TICRATE));
+		store.timer = NetSimDeliveryTime();
 		InBuffer.Push(store);
 		doomcom.remotenode = -1;
 	}
 	
 	if (doomcom.remotenode == -1)
 	{
-		bool gotmessage = false;
-		for (unsigned int i = 0; i < InBuffer.Size(); i++)
-		{
-			if (InBuffer[i].timer <= I_GetTime())
-			{
-				doomcom = InBuffer[i].message;
-				InBuffer.Delete(i);
-				gotmessage = true;
-				break;
-			}
-		}
-		if (!gotmessage)
+		int due = NetSimNextDue(InBuffer);
+		if (due < 0)
 			return false;
+
+		doomcom = InBuffer[due].message;
+		InBuffer.Delete(due);
 	}
-#else
-	if (doomcom.remotenode == -1)
-	{
-		return false;
-	}
-#endif
 		
 	if (debugfile)
 	{
@@ -1916,6 +1973,10 @@ void TryRunTics (void)
 	{
 		availabletics = lowtic - gametic / ticdup;
 	}
+	if (netgame)
+	{
+		netstats.AddDepth (availabletics);
+	}
 
 	// decide how many tics to run
 	if (realtics < availabletics-1)
@@ -1929,6 +1990,8 @@ void TryRunTics (void)
 	if (counts == 0 && !doWait)
 	{
 		TicStabilityWait();
+		if (realtics >= 1)
+			netstats.Stalls++;
 
 		// Check possible stall conditions
 		Net_CheckLastReceived(counts);
@@ -1976,6 +2039,7 @@ void TryRunTics (void)
 		// don't stay in here forever -- give the menu a chance to work
 		if (I_GetTime () - entertic >= 1)
 		{
+			netstats.Stalls++;
 			C_Ticker ();
 			M_Ticker ();
 			// Repredict the player for new buffered movement
@@ -2011,6 +2075,7 @@ void TryRunTics (void)
 			M_Ticker ();
 			G_Ticker();
 			gametic++;
+			netstats.TicsRun++;
 
 			NetUpdate ();	// check for new console commands
 			TicStabilityEnd();
@@ -2984,6 +3049,45 @@ CCMD (pings)
 		if (playeringame[i])
 			Printf ("% 4" PRId64 " %s\n", currrecvtime[i] - lastrecvtime[i],
 					players[i].userinfo.GetName());
+
+	// Traffic per remote node, including the cost of (de)compressing it.
+	// These are averages over the whole session, not current rates.
+	if (netgame && gametic > 0)
+	{
+		double seconds = gametic / (double)TICRATE;
+		Printf ("Session averages:\n");
+		Printf ("node    out B/s (raw)        in B/s (raw)    zip ms/s unzip ms/s\n");
+		for (i = 1; i < doomcom.numnodes; i++)
+		{
+			if (!nodeingame[i])
+				continue;
+
+			const FNetNodeStats &stats = netnodestats[i];
+			Printf ("%4d %7.0f (%7.0f) %7.0f (%7.0f) %9.3f %9.3f  %s\n", i,
+				stats.BytesSent / seconds, stats.RawBytesSent / seconds,
+				stats.BytesRecv / seconds, stats.RawBytesRecv / seconds,
+				stats.CompressMS / seconds, stats.DecompressMS / seconds,
+				players[playerfornode[i]].userinfo.GetName());
+		}
+	}
+}
+
+ADD_STAT (net)
+{
+	FString out;
+	if (!netgame)
+	{
+		out = "Not in a netgame";
+		return out;
+	}
+	out.Format ("Tics run %d, stalls %d - buffered tics %d (min %d, max %d, avg %.2f)\n"
+		"Simulated: %d ms latency, %d ms jitter, %d%% loss - queued out %d, in %d, dropped %d",
+		netstats.TicsRun, netstats.Stalls, netstats.Depth,
+		netstats.DepthSamples > 0 ? netstats.MinDepth : 0, netstats.MaxDepth,
+		netstats.DepthSamples > 0 ? netstats.DepthSum / netstats.DepthSamples : 0.,
+		*net_fakelatency, *net_fakejitter, *net_fakeloss,
+		OutBuffer.Size(), InBuffer.Size(), netstats.Dropped);
+	return out;
 }
 
 //==========================================================================
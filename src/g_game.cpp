@@ -181,6 +181,8 @@ size_t			maxdemosize;
 uint8_t*			zdemformend;			// end of FORM ZDEM chunk
 uint8_t*			zdembodyend;			// end of ZDEM BODY chunk
 bool 			singledemo; 			// quit after playing a demo from cmdline 
+FString			demohashname;			// -hashdemo: write a per-tic playsim hash while timing a demo
+FileWriter*		demohashfile;
  
 bool 			precache = true;		// if true, load all graphics at start 
   
@@ -1131,6 +1133,61 @@ static uint32_t StaticSumSeeds()
 		pr_damagemobj.Seed();
 }
 
+//==========================================================================
+//
+// G_WriteTicHash
+//
+// Writes a hash of the playsim state for the current tic to the -hashdemo
+// file. Two builds playing the same demo must produce identical streams,
+// so the first differing line pinpoints the tic where they diverged.
+//
+//==========================================================================
+
+static void G_WriteTicHash()
+{
+	struct ActorHashState
+	{
+		double pos[3];
+		double vel[3];
+		uint32_t yaw, pitch;
+		int32_t health;
+		int32_t tics;
+		int32_t sprite;
+		int32_t frame;
+		uint32_t flags;
+	};
+
+	uint32_t crc = FRandom::StaticHashRNGState(0);
+	int count = 0;
+
+	auto it = primaryLevel->GetThinkerIterator<AActor>();
+	AActor *ac;
+	while ((ac = it.Next()) != nullptr)
+	{
+		ActorHashState hs;
+		memset(&hs, 0, sizeof(hs));
+		hs.pos[0] = ac->X();
+		hs.pos[1] = ac->Y();
+		hs.pos[2] = ac->Z();
+		hs.vel[0] = ac->Vel.X;
+		hs.vel[1] = ac->Vel.Y;
+		hs.vel[2] = ac->Vel.Z;
+		hs.yaw = ac->Angles.Yaw.BAMs();
+		hs.pitch = ac->Angles.Pitch.BAMs();
+		hs.health = ac->health;
+		hs.tics = ac->tics;
+		if (ac->state != nullptr)
+		{
+			hs.sprite = ac->state->sprite;
+			hs.frame = ac->state->Frame;
+		}
+		hs.flags = ac->flags.GetValue();
+		crc = AddCRC32(crc, (const uint8_t *)&hs, sizeof(hs));
+		count++;
+	}
+	demohashfile->Printf("%d %d %08x\n", gametic, count, crc);
+}
+
 //
 // G_Ticker
 // Make ticcmd_ts for the players.
@@ -1323,6 +1380,10 @@ void G_Ticker ()
 	case GS_LEVEL:
 		P_Ticker ();
 		primaryLevel->automap->Ticker ();
+		if (demohashfile != nullptr && demoplayback)
+		{
+			G_WriteTicHash ();
+		}
 		break;
 
 	case GS_TITLELEVEL:
@@ -2968,6 +3029,15 @@ void G_DoPlayDemo (void)
 		demonew = false;
 		precache = true;
 
+		if (timingdemo && demohashname.IsNotEmpty() && demohashfile == nullptr)
+		{
+			demohashfile = FileWriter::Open(demohashname.GetChars());
+			if (demohashfile == nullptr)
+			{
+				I_Error("Unable to open '%s' for writing", demohashname.GetChars());
+			}
+		}
+
 		usergame = false;
 		demoplayback = true;
 		playedtitlemusic = false;
@@ -2984,6 +3054,14 @@ void G_TimeDemo (const char* name)
 	timingdemo = true;
 	singletics = true;
 
+	// Verification runs only care about the playsim, so skip rendering entirely.
+	const char *hashname = Args->CheckValue ("-hashdemo");
+	demohashname = hashname != nullptr ? hashname : "";
+	if (demohashname.IsNotEmpty())
+	{
+		nodrawers = true;
+	}
+
 	defdemoname = name;
 	gameaction = (gameaction == ga_loadgame) ? ga_loadgameplaydemo : ga_playdemo;
 }
@@ -3014,6 +3092,12 @@ bool G_CheckDemoStatus (void)
 		if (timingdemo)
 			endtime = I_GetTime () - starttime;
 
+		if (demohashfile != nullptr)
+		{
+			delete demohashfile;
+			demohashfile = nullptr;
+		}
+
 		C_RestoreCVars ();		// [RH] Restore cvars demo might have changed
 		M_Free (demobuffer);
 		demobuffer = NULL;
@@ -493,6 +493,7 @@ public:
 
 	// [ZZ] Destructible geometry information
 	TMap<int, FHealthGroup> healthGroups;
+	bool hasDestructibleGeometry = false;	// set once anything has health > 0. Only recomputed on level load.
 
 	FBlockmap blockmap;
 	TArray<polyblock_t *> PolyBlockMap;
@@ -407,6 +407,7 @@ void PClassActor::StaticInit()
 		}
 	}
 
+	InitScriptVirtuals();
 	LoadAltHudStuff();
 	InitBotStuff();
 
@@ -414,6 +415,46 @@ void PClassActor::StaticInit()
 	staticEventManager.InitStaticHandlers(primaryLevel, false);
 }
 
+//==========================================================================
+//
+// PClassActor :: InitScriptVirtuals								STATIC
+//
+// Records for every actor class which of the EActorVirtual functions it
+// overrides in script. Classes that do not get set up here (i.e. anything
+// created after loading) keep all bits set and always use the VM.
+//
+//==========================================================================
+
+void PClassActor::InitScriptVirtuals()
+{
+	static const char *const names[NUM_AVIRT] =
+	{
+		"Touch", "Grind", "FallAndSink", "Slam", "SpecialMissileHit", "SpecialBounceHit",
+		"CollidedWith", "CanCollideWith", "DoSpecialDamage", "TakeSpecialDamage"
+	};
+	auto base = RUNTIME_CLASS(AActor);
+	unsigned indices[NUM_AVIRT];
+
+	for (int i = 0; i < NUM_AVIRT; i++)
+	{
+		indices[i] = GetVirtualIndex(base, names[i]);
+		assert(indices[i] < base->Virtuals.Size());
+	}
+	for (auto cls : AllActorClasses)
+	{
+		uint32_t overridden = 0;
+		for (int i = 0; i < NUM_AVIRT; i++)
+		{
+			unsigned index = indices[i];
+			if (index >= base->Virtuals.Size() || index >= cls->Virtuals.Size() || cls->Virtuals[index] != base->Virtuals[index])
+			{
+				overridden |= 1u << i;
+			}
+		}
+		cls->ActorInfo()->ScriptVirtuals = overridden;
+	}
+}
+
 //==========================================================================
 //
 // PClassActor :: StaticSetActorNums								STATIC
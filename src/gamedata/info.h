@@ -237,6 +237,25 @@ private:
 
 struct FDropItem;
 
+// Actor virtuals whose default implementation is either native or empty.
+// If a class does not override them in script the engine calls the default
+// directly instead of going through the VM.
+enum EActorVirtual
+{
+	AVIRT_Touch,
+	AVIRT_Grind,
+	AVIRT_FallAndSink,
+	AVIRT_Slam,
+	AVIRT_SpecialMissileHit,
+	AVIRT_SpecialBounceHit,
+	AVIRT_CollidedWith,
+	AVIRT_CanCollideWith,
+	AVIRT_DoSpecialDamage,
+	AVIRT_TakeSpecialDamage,
+
+	NUM_AVIRT
+};
+
 struct FActorInfo
 {
 	TArray<FInternalLightAssociation *> LightAssociations;
@@ -266,6 +285,7 @@ struct FActorInfo
 	FString DisplayName;
 
 	uint8_t DefaultStateUsage = 0; // state flag defaults for blocks without a qualifier.
+	uint32_t ScriptVirtuals = ~0u;	// EActorVirtual bits overridden in script. Not inherited, set up by InitScriptVirtuals.
 
 	FActorInfo() = default;
 	FActorInfo(const FActorInfo & other)
@@ -299,6 +319,7 @@ protected:
 public:
 	static void StaticInit ();
 	static void StaticSetActorNums ();
+	static void InitScriptVirtuals ();
 
 	void BuildDefaults();
 	void ApplyDefaults(uint8_t *defaults);
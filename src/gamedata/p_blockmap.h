@@ -16,7 +16,7 @@ struct FBlockNode
 	FBlockNode **PrevBlock;			// previous block this actor is in
 	FBlockNode *NextBlock;			// next block this actor is in
 
-	static FBlockNode *Create (AActor *who, int x, int y, int group = -1);
+	static FBlockNode *Create (AActor *who, int x, int y, int group = -1, FBlockNode **reuse = nullptr);
 	void Release ();
 
 	static FBlockNode *FreeBlocks;
@@ -581,6 +581,7 @@ struct extsector_t
 		TDeletingArray<F3DFloor *>		ffloors;		// 3D floors in this sector
 		TArray<lightlist_t>				lightlist;		// 3D light list
 		TArray<sector_t*>				attached;		// 3D floors attached to this sector
+		TArray<unsigned>				solid;			// indices of the existing solid 3D floors, in ffloors order
 	} XFloor;
 
 	TArray<vertex_t *> vertices;
@@ -65,6 +65,7 @@
 #include "a_dynlight.h"
 #include "events.h"
 #include "p_destructible.h"
+#include "p_enemy.h"
 #include "types.h"
 #include "i_time.h"
 #include "vm.h"
@@ -295,6 +296,7 @@ void FLevelLocals::ClearLevelData(bool fullgc)
 	}
 	
 	interpolator.ClearInterpolations();	// [RH] Nothing to interpolate on a fresh level.
+	P_ClearFlowFields();
 	Thinkers.DestroyAllThinkers(fullgc);
 	ClearAllSubsectorLinks(); // can't be done as part of the polyobj deletion process.
 
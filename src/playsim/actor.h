@@ -818,6 +818,15 @@ public:
 		return static_cast<PClassActor*>(GetClass())->ActorInfo();
 	}
 
+	// True if the class does not override the given virtual in script,
+	// so the caller can use the default implementation without the VM.
+	bool NativeVirtual(EActorVirtual func) const
+	{
+		if (GetInfo()->ScriptVirtuals & (1u << func)) return false;
+		NativeVirtualCalls++;
+		return true;
+	}
+
 
 	FDropItem *GetDropItems() const;
 
@@ -828,6 +837,7 @@ public:
 	void AlterWeaponSprite(visstyle_t *vis);
 
 	bool CheckNoDelay();
+	bool TryIdleTick();
 
 	virtual void BeginPlay();			// Called immediately after the actor is created
 	void CallBeginPlay();
@@ -1111,10 +1121,33 @@ public:
 	void AttachLight(unsigned int count, const FLightDefaults *lightdef);
 	void SetDynamicLights();
 
-// info for drawing
 // NOTE: The first member variable *must* be snext.
 	AActor			*snext, **sprev;	// links in sector (if needed)
+
+// Hot data: everything the thinker loop, blockmap scans and sprite collection
+// look at for nearly every actor is kept together at the start of the object.
+// Only the C++ layout changes here, script fields and savegames go by name.
 	DVector3		__Pos;		// double underscores so that it won't get used by accident. Access to this should be exclusively through the designated access functions.
+	DVector3		Vel;
+	double			radius, Height;		// for movement checking
+	double			floorz, ceilingz;	// closest together of contacted secs
+	ActorFlags		flags;
+	ActorFlags2		flags2;			// Heretic flags
+	ActorFlags3		flags3;			// [RH] Hexen/Heretic actor-dependant behavior made flaggable
+	ActorFlags4		flags4;			// [RH] Even more flags!
+	ActorFlags5		flags5;			// OMG! We need another one.
+	ActorFlags6		flags6;			// Shit! Where did all the flags go?
+	ActorFlags7		flags7;			// WHO WANTS TO BET ON 8!?
+	ActorFlags8		flags8;			// I see your 8, and raise you a bet for 9.
+	ActorFlags9		flags9;			// Happy ninth actor flag field GZDoom !
+	int32_t			tics;				// state tic counter
+	FState			*state;
+	FBlockNode		*BlockNode;			// links in blocks (if needed)
+	struct sector_t	*Sector;
+	struct msecnode_t	*touching_sectorlist;	// phares 3/14/98: a linked list of sectors where this object appears
+	int validcount;
+
+// info for drawing
 
 	DAngle			SpriteAngle;
 	DAngle			SpriteRotation;
@@ -1140,17 +1173,7 @@ public:
 	bool				NoLocalRender;		// DO NOT EXPORT THIS! This is a way to disable rendering such that the playsim cannot access it.
 	ActorRenderFlags	renderflags;		// Different rendering flags
 	ActorRenderFlags2	renderflags2;		// More rendering flags...
-	ActorFlags		flags;
-	ActorFlags2		flags2;			// Heretic flags
-	ActorFlags3		flags3;			// [RH] Hexen/Heretic actor-dependant behavior made flaggable
-	ActorFlags4		flags4;			// [RH] Even more flags!
-	ActorFlags5		flags5;			// OMG! We need another one.
-	ActorFlags6		flags6;			// Shit! Where did all the flags go?
-	ActorFlags7		flags7;			// WHO WANTS TO BET ON 8!?
-	ActorFlags8		flags8;			// I see your 8, and raise you a bet for 9.
-	ActorFlags9		flags9;			// Happy ninth actor flag field GZDoom !
 	double			Floorclip;		// value to use for floor clipping
-	double			radius, Height;		// for movement checking
 
 	FAngle			VisibleStartAngle;
 	FAngle			VisibleStartPitch;
@@ -1158,7 +1181,6 @@ public:
 	FAngle			VisibleEndPitch;
 
 	DVector3		OldRenderPos;
-	DVector3		Vel;
 	DVector2		SpriteOffset;
 	DVector3		WorldOffset;
 	double			Speed;
@@ -1167,11 +1189,8 @@ public:
 	TObjPtr<DBoneComponents*>		boneComponentData;
 
 // interaction info
-	FBlockNode		*BlockNode;			// links in blocks (if needed)
-	struct sector_t	*Sector;
 	subsector_t *		subsector;
 	FSection *			section;
-	double			floorz, ceilingz;	// closest together of contacted secs
 	double			dropoffz;		// killough 11/98: the lowest floor over all contacted Sectors.
 
 	uint32_t		ThruBits;
@@ -1192,8 +1211,6 @@ public:
 	double			StealthAlpha;	// Minmum alpha for MF_STEALTH.
 	int				WoundHealth;		// Health needed to enter wound state
 
-	int32_t			tics;				// state tic counter
-	FState			*state;
 	//VMFunction		*Damage;			// For missiles and monster railgun
 	int				DamageVal;
 	int				projectileKickback;
@@ -1297,12 +1314,13 @@ public:
 	int PoisonPeriodReceived; // How often poison damage is applied. (Every X tics.)
 	TObjPtr<AActor*> Poisoner; // Last source of received poison damage.
 
-	// a linked list of sectors where this object appears
-	struct msecnode_t	*touching_sectorlist;				// phares 3/14/98
 	struct msecnode_t	*touching_sectorportallist;		// same for cross-sectorportal rendering
 	struct portnode_t	*touching_lineportallist;		// and for cross-lineportal
 	struct msecnode_t	*touching_rendersectors; // this is the list of sectors that this thing interesects with it's max(radius, renderradius).
-	int validcount;
+	// What the sector lists above were last built for. Lets LinkToWorld skip rebuilding them.
+	sector_t		*LinkSector;
+	DVector2		LinkPos;
+	double			LinkRadius, LinkRenderRadius;
 
 
 	TObjPtr<AActor*>	Inventory;		// [RH] This actor's inventory
@@ -47,11 +47,18 @@
 #include "d_main.h"
 
 static int ThinkCount;
+int NativeVirtualCalls;
+static int IdleActorCount, ActiveActorCount, IdleActorPeak;
+static unsigned IteratorVisits, IteratorReturns;
 static cycle_t ThinkCycles;
 extern cycle_t BotSupportCycles;
 extern cycle_t ActionCycles;
 extern int BotWTG;
 
+// Let monsters that are just counting down an idle state skip their Tick.
+// See AActor::TryIdleTick for the conditions.
+CVAR(Bool, sv_idleactorfastpath, false, CVAR_SERVERINFO | CVAR_ARCHIVE)
+
 IMPLEMENT_CLASS(DThinker, false, false)
 
 struct ProfileInfo
@@ -101,6 +108,8 @@ void FThinkerCollection::RunThinkers(FLevelLocals *Level)
 	int i, count;
 
 	ThinkCount = 0;
+	NativeVirtualCalls = 0;
+	IdleActorCount = ActiveActorCount = 0;
 	ThinkCycles.Reset();
 	BotSupportCycles.Reset();
 	ActionCycles.Reset();
@@ -263,6 +272,7 @@ void FThinkerCollection::RunThinkers(FLevelLocals *Level)
 	}
 
 	ThinkCycles.Unclock();
+	if (IdleActorCount > IdleActorPeak) IdleActorPeak = IdleActorCount;
 }
 
 //==========================================================================
@@ -276,6 +286,9 @@ void FThinkerCollection::DestroyAllThinkers(bool fullgc)
 	int i;
 	bool error = false;
 
+	// The peak only means something for the level it was taken in.
+	IdleActorPeak = 0;
+
 	for (i = 0; i <= MAX_STATNUM; i++)
 	{
 		if (i != STAT_TRAVELLING && i != STAT_STATIC)
@@ -372,6 +385,22 @@ void FThinkerCollection::SerializeThinkers(FSerializer &arc, bool hubLoad)
 }
 
 
+//==========================================================================
+//
+// Keeps PClass::LiveThinkers up to date for the thinker and all its
+// ancestors whenever it enters or leaves a thinker list.
+//
+//==========================================================================
+
+static void CountLiveThinker(DThinker *thinker, int delta)
+{
+	if (thinker->ObjectFlags & OF_Sentinel) return;
+	for (PClass *cls = thinker->GetClass(); cls != nullptr; cls = cls->ParentClass)
+	{
+		cls->LiveThinkers += delta;
+	}
+}
+
 //==========================================================================
 //
 //
@@ -401,6 +430,7 @@ void FThinkerList::AddTail(DThinker *thinker)
 	GC::WriteBarrier(thinker, Sentinel);
 	GC::WriteBarrier(tail, thinker);
 	GC::WriteBarrier(Sentinel, thinker);
+	CountLiveThinker(thinker, 1);
 }
 
 //==========================================================================
@@ -522,6 +552,7 @@ bool FThinkerList::DoDestroyThinkers()
 			auto next = node->NextThinker;
 			toDelete.Push(node);
 			node->NextThinker = node->PrevThinker = nullptr;	// clear the links
+			CountLiveThinker(node, -1);
 			node = next;
 		}
 		Sentinel->NextThinker = Sentinel->PrevThinker = nullptr;
@@ -615,7 +646,22 @@ int FThinkerList::TickThinkers(FThinkerList *dest)
 		if (!(node->ObjectFlags & OF_EuthanizeMe))
 		{ // Only tick thinkers not scheduled for destruction
 			ThinkCount++;
-			node->CallTick();
+			if (sv_idleactorfastpath && node->IsKindOf(NAME_Actor))
+			{
+				if (static_cast<AActor*>(node)->TryIdleTick())
+				{
+					IdleActorCount++;
+				}
+				else
+				{
+					ActiveActorCount++;
+					node->CallTick();
+				}
+			}
+			else
+			{
+				node->CallTick();
+			}
 			node->ObjectFlags &= ~OF_JustSpawned;
 		}
 		node = NextToThink;
@@ -727,6 +773,7 @@ void DThinker::Remove()
 	GC::WriteBarrier(next, prev);
 	NextThinker = nullptr;
 	PrevThinker = nullptr;
+	CountLiveThinker(this, -1);
 }
 
 //==========================================================================
@@ -893,6 +940,14 @@ void DThinker::CallTick()
 {
 	IFVIRTUAL(DThinker, Tick)
 	{
+		// If Tick is not overridden in script, the VM would only call the
+		// native thunk which ends up here anyway.
+		if (func == RUNTIME_CLASS(DThinker)->Virtuals[VIndex])
+		{
+			NativeVirtualCalls++;
+			Tick();
+			return;
+		}
 		// Without the type cast this picks the 'void *' assignment...
 		VMValue params[1] = { (DObject*)this };
 		VMCall(func, params, 1, nullptr, 0);
@@ -991,7 +1046,8 @@ void FThinkerIterator::Reinit ()
 
 DThinker *FThinkerIterator::Next (bool exact)
 {
-	if (m_ParentType == nullptr)
+	// Nothing of this type exists in any thinker list so there is no need to look.
+	if (m_ParentType == nullptr || m_ParentType->LiveThinkers <= 0)
 	{
 		return nullptr;
 	}
@@ -1005,12 +1061,10 @@ DThinker *FThinkerIterator::Next (bool exact)
 				{
 					DThinker *thinker = m_CurrThinker;
 					m_CurrThinker = thinker->NextThinker;
-					if (exact)
-					{
-						if (thinker->IsA(m_ParentType)) return thinker;
-					}
-					else if (thinker->IsKindOf(m_ParentType))
+					IteratorVisits++;
+					if (exact ? thinker->IsA(m_ParentType) : thinker->IsKindOf(m_ParentType))
 					{
+						IteratorReturns++;
 						return thinker;
 					}
 					// This can actually happen when a Destroy call on 'thinker' happens to destroy 'm_CurrThinker'.
@@ -1049,3 +1103,41 @@ ADD_STAT (think)
 	out.Format ("Think time = %04.2f ms - %d thinkers, Action = %04.2f ms", ThinkCycles.TimeMS(), ThinkCount, ActionCycles.TimeMS());
 	return out;
 }
+
+ADD_STAT (iterators)
+{
+	static unsigned lastvisits, lastreturns;
+	static int lasttic;
+	FString out;
+	int tics = max(1, gametic - lasttic);
+	out.Format ("Thinker iterators per tic: %.1f visited, %.1f returned",
+		double(IteratorVisits - lastvisits) / tics, double(IteratorReturns - lastreturns) / tics);
+	if (gametic != lasttic)
+	{
+		lastvisits = IteratorVisits;
+		lastreturns = IteratorReturns;
+		lasttic = gametic;
+	}
+	return out;
+}
+
+ADD_STAT (virtuals)
+{
+	FString out;
+	out.Format ("VM calls avoided = %d", NativeVirtualCalls);
+	return out;
+}
+
+ADD_STAT (idle)
+{
+	FString out;
+	if (!sv_idleactorfastpath)
+	{
+		out = "sv_idleactorfastpath is off";
+	}
+	else
+	{
+		out.Format ("Idle actors = %d (peak %d), active actors = %d", IdleActorCount, IdleActorPeak, ActiveActorCount);
+	}
+	return out;
+}
@@ -50,6 +50,8 @@ class FThinkerIterator;
 
 enum { MAX_STATNUM = 127 };
 
+extern int NativeVirtualCalls;	// VM calls skipped this tic because the default implementation was called directly
+
 // Doubly linked ring list of thinkers
 struct FThinkerList
 {
@@ -100,6 +100,27 @@ void F3DFloor::UpdateColormap(FColormap &map)
 	}
 }
 
+//==========================================================================
+//
+// Collects the 3D floors the collision code needs to look at.
+// This must be redone whenever the ffloors array or the floors' flags change
+// which only happens here and when the dynamic data is cleared.
+//
+//==========================================================================
+
+static void P_UpdateSolid3DFloors(sector_t *sector)
+{
+	auto &xf = sector->e->XFloor;
+	xf.solid.Clear();
+	for (unsigned i = 0; i < xf.ffloors.Size(); i++)
+	{
+		if ((xf.ffloors[i]->flags & (FF_EXISTS | FF_SOLID)) == (FF_EXISTS | FF_SOLID))
+		{
+			xf.solid.Push(i);
+		}
+	}
+}
+
 //==========================================================================
 //
 // Add one 3D floor to the sector
@@ -186,6 +207,7 @@ void P_Add3DFloor(sector_t* sec, sector_t* sec2, line_t* master, int flags, int
 	}
 
 	sec->e->XFloor.ffloors.Push(ffloor);
+	P_UpdateSolid3DFloors(sec);
 
 	// kg3D - software renderer only hack
 	// this is really required because of ceilingclip and floorclip
@@ -246,11 +268,12 @@ bool P_CheckFor3DFloorHit(AActor * mo, double z, bool trigger)
 {
 	if ((mo->player && (mo->player->cheats & CF_PREDICTING))) return false;
 
-	for (auto rover : mo->Sector->e->XFloor.ffloors)
+	auto &xf = mo->Sector->e->XFloor;
+	for (unsigned i : xf.solid)
 	{
-		if (!(rover->flags & FF_EXISTS)) continue;
+		F3DFloor *rover = xf.ffloors[i];
 
-		if(rover->flags & FF_SOLID && rover->model->SecActTarget)
+		if(rover->model->SecActTarget)
 		{
 			if (fabs(z - rover->top.plane->ZatPoint(mo)) < EQUAL_EPSILON) 
 			{
@@ -274,11 +297,12 @@ bool P_CheckFor3DCeilingHit(AActor * mo, double z, bool trigger)
 {
 	if ((mo->player && (mo->player->cheats & CF_PREDICTING))) return false;
 
-	for (auto rover : mo->Sector->e->XFloor.ffloors)
+	auto &xf = mo->Sector->e->XFloor;
+	for (unsigned i : xf.solid)
 	{
-		if (!(rover->flags & FF_EXISTS)) continue;
+		F3DFloor *rover = xf.ffloors[i];
 
-		if(rover->flags & FF_SOLID && rover->model->SecActTarget)
+		if(rover->model->SecActTarget)
 		{
 			if(fabs(z - rover->bottom.plane->ZatPoint(mo)) < EQUAL_EPSILON)
 			{
@@ -545,6 +569,7 @@ void P_Recalculate3DFloors(sector_t * sector)
 			}
 		}
 	}
+	P_UpdateSolid3DFloors(sector);
 }
 
 //==========================================================================
@@ -578,6 +603,7 @@ void FLevelLocals::ClearDynamic3DFloorData()
 				rover->flags |= FF_EXISTS;
 			}
 		}
+		P_UpdateSolid3DFloors(&sec);
 	}
 }
 
@@ -703,13 +729,10 @@ void P_LineOpening_XFloors (FLineOpening &open, AActor * thing, const line_t *li
 			
 			for(int j=0;j<2;j++)
 			{
-				for(unsigned i=0;i<xf[j]->ffloors.Size();i++)
+				for (unsigned i : xf[j]->solid)
 				{
 					F3DFloor *rover = xf[j]->ffloors[i];
 
-					if (!(rover->flags & FF_EXISTS)) continue;
-					if (!(rover->flags & FF_SOLID)) continue;
-					
 					double ff_bottom=rover->bottom.plane->ZatPoint(x, y);
 					double ff_top=rover->top.plane->ZatPoint(x, y);
 					
@@ -797,9 +820,9 @@ secplane_t P_FindFloorPlane(sector_t * sector, const DVector3 &pos)
 	secplane_t retplane = sector->floorplane;
 	if (sector->e)	// apparently this can be called when the data is already gone
 	{
-		for(auto rover : sector->e->XFloor.ffloors)
+		for (unsigned i : sector->e->XFloor.solid)
 		{
-			if(!(rover->flags & FF_SOLID) || !(rover->flags & FF_EXISTS)) continue;
+			F3DFloor *rover = sector->e->XFloor.ffloors[i];
 
 			if (rover->top.plane->ZatPoint(pos) == pos.Z)
 			{
@@ -835,13 +858,11 @@ int	P_Find3DFloor(sector_t * sec, const DVector3 &pos, bool above, bool floor, d
 		return -1;
 
 	// Looking through planes from top to bottom
-	for (int i = 0; i < (signed)sec->e->XFloor.ffloors.Size(); ++i)
+	// We are only interested in solid 3D floors here
+	for (int i : sec->e->XFloor.solid)
 	{
 		F3DFloor *rover = sec->e->XFloor.ffloors[i];
 
-		// We are only interested in solid 3D floors here
-		if(!(rover->flags & FF_SOLID) || !(rover->flags & FF_EXISTS)) continue;
-
 		if (above)
 		{
 			// z is above that floor
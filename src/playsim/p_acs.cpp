@@ -932,8 +932,9 @@ void ACSStringPool::PoolEntry::Unlock(int levelnum)
 
 ACSStringPool::ACSStringPool()
 {
-	memset(PoolBuckets, 0xFF, sizeof(PoolBuckets));
-	FirstFreeEntry = 0;
+	MinorCollections = MajorCollections = LastFreed = TotalFreed = 0;
+	MarkEpoch = 1;
+	Clear();
 }
 
 //============================================================================
@@ -947,8 +948,12 @@ ACSStringPool::ACSStringPool()
 void ACSStringPool::Clear()
 {
 	Pool.Clear();
-	memset(PoolBuckets, 0xFF, sizeof(PoolBuckets));
-	FirstFreeEntry = 0;
+	FreeEntries.Clear();
+	Nursery.Clear();
+	LiveCount = 0;
+	StringBytes = 0;
+	MinorsSinceMajor = 0;
+	Rehash();
 }
 
 //============================================================================
@@ -965,26 +970,24 @@ int ACSStringPool::AddString(const char *str)
 	if (str == nullptr) str = "";
 	size_t len = strlen(str);
 	unsigned int h = SuperFastHash(str, len);
-	unsigned int bucketnum = h % NUM_BUCKETS;
-	int i = FindString(str, len, h, bucketnum);
+	int i = FindString(str, len, h);
 	if (i >= 0)
 	{
 		return i | STRPOOL_LIBRARYID_OR;
 	}
 	FString fstr(str);
-	return InsertString(fstr, h, bucketnum);
+	return InsertString(fstr, h);
 }
 
 int ACSStringPool::AddString(FString &str)
 {
 	unsigned int h = SuperFastHash(str.GetChars(), str.Len());
-	unsigned int bucketnum = h % NUM_BUCKETS;
-	int i = FindString(str.GetChars(), str.Len(), h, bucketnum);
+	int i = FindString(str.GetChars(), str.Len(), h);
 	if (i >= 0)
 	{
 		return i | STRPOOL_LIBRARYID_OR;
 	}
-	return InsertString(str, h, bucketnum);
+	return InsertString(str, h);
 }
 
 //============================================================================
@@ -1034,7 +1037,7 @@ void ACSStringPool::MarkString(int strnum)
 	assert((strnum & LIBRARYID_MASK) == STRPOOL_LIBRARYID_OR);
 	strnum &= ~LIBRARYID_MASK;
 	assert((unsigned)strnum < Pool.Size());
-	Pool[strnum].Mark = true;
+	Pool[strnum].Mark = MarkEpoch;
 }
 
 //============================================================================
@@ -1083,7 +1086,7 @@ void ACSStringPool::MarkStringArray(const int *strnum, unsigned int count)
 			num &= ~LIBRARYID_MASK;
 			if ((unsigned)num < Pool.Size())
 			{
-				Pool[num].Mark = true;
+				Pool[num].Mark = MarkEpoch;
 			}
 		}
 	}
@@ -1110,7 +1113,7 @@ void ACSStringPool::MarkStringMap(const FWorldGlobalArray &aray)
 			num &= ~LIBRARYID_MASK;
 			if ((unsigned)num < Pool.Size())
 			{
-				Pool[num].Mark |= true;
+				Pool[num].Mark = MarkEpoch;
 			}
 		}
 	}
@@ -1129,11 +1132,35 @@ void ACSStringPool::UnlockAll()
 {
 	for (unsigned int i = 0; i < Pool.Size(); ++i)
 	{
-		Pool[i].Mark = false;
+		Pool[i].Mark = MarkEpoch - 1;
 		Pool[i].Locks.Clear();
 	}
 }
 
+//============================================================================
+//
+// ACSStringPool :: CollectStrings
+//
+// Called after all string references have been marked. Most strings built
+// by scripts are only needed for a tic or two, so usually only the strings
+// that have not survived PROMOTE_AGE collections yet are swept. Every
+// MAJOR_GC_INTERVAL collections the entire pool is swept instead, so that
+// old strings that became unreferenced eventually get freed as well.
+//
+//============================================================================
+
+void ACSStringPool::CollectStrings()
+{
+	if (++MinorsSinceMajor >= MAJOR_GC_INTERVAL)
+	{
+		PurgeStrings();
+	}
+	else
+	{
+		SweepNursery();
+	}
+}
+
 //============================================================================
 //
 // ACSStringPool :: PurgeStrings
@@ -1144,39 +1171,151 @@ void ACSStringPool::UnlockAll()
 
 void ACSStringPool::PurgeStrings()
 {
-	// Clear the hash buckets. We'll rebuild them as we decide what strings
-	// to keep and which to toss.
-	memset(PoolBuckets, 0xFF, sizeof(PoolBuckets));
-	size_t usedcount = 0, freedcount = 0;
+	Nursery.Clear();
+	LastFreed = 0;
 	for (unsigned int i = 0; i < Pool.Size(); ++i)
 	{
 		PoolEntry *entry = &Pool[i];
 		if (entry->Next != FREE_ENTRY)
 		{
-			if (entry->Locks.Size() == 0 && !entry->Mark)
+			if (entry->Locks.Size() == 0 && entry->Mark != MarkEpoch)
 			{
-				freedcount++;
-				// Mark this entry as free.
+				// Mark this entry as free and free the string.
+				// The hash chains get rebuilt below.
+				LastFreed++;
+				LiveCount--;
+				StringBytes -= entry->Str.Len() + 1;
 				entry->Next = FREE_ENTRY;
-				if (i < FirstFreeEntry)
-				{
-					FirstFreeEntry = i;
-				}
-				// And free the string.
 				entry->Str = "";
 			}
 			else
 			{
-				usedcount++;
-				// Rehash this entry.
-				unsigned int h = entry->Hash % NUM_BUCKETS;
-				entry->Next = PoolBuckets[h];
-				PoolBuckets[h] = i;
-				// Remove MarkString's mark.
-				entry->Mark = false;
+				entry->Next = NO_ENTRY;
+				if (entry->Age < PROMOTE_AGE && ++entry->Age < PROMOTE_AGE)
+				{
+					Nursery.Push(i);
+				}
 			}
 		}
 	}
+	Rehash();
+	RebuildFreeList();
+
+	TotalFreed += LastFreed;
+	MajorCollections++;
+	MinorsSinceMajor = 0;
+	// Forget all marks from this collection.
+	MarkEpoch++;
+}
+
+//============================================================================
+//
+// ACSStringPool :: SweepNursery
+//
+// Frees the unreferenced strings among the young ones and ages the rest.
+//
+//============================================================================
+
+void ACSStringPool::SweepNursery()
+{
+	unsigned int kept = 0;
+	LastFreed = 0;
+	for (unsigned int i = 0; i < Nursery.Size(); ++i)
+	{
+		unsigned int index = Nursery[i];
+		PoolEntry *entry = &Pool[index];
+		assert(entry->Next != FREE_ENTRY);
+		if (entry->Locks.Size() == 0 && entry->Mark != MarkEpoch)
+		{
+			FreeEntry(index);
+		}
+		else if (++entry->Age < PROMOTE_AGE)
+		{
+			Nursery[kept++] = index;
+		}
+	}
+	Nursery.Resize(kept);
+
+	TotalFreed += LastFreed;
+	MinorCollections++;
+	MarkEpoch++;
+}
+
+//============================================================================
+//
+// ACSStringPool :: FreeEntry
+//
+// Unlinks a single entry from its hash chain and puts it on the free list.
+//
+//============================================================================
+
+void ACSStringPool::FreeEntry(unsigned int index)
+{
+	PoolEntry *entry = &Pool[index];
+	unsigned int *link = &PoolBuckets[Bucket(entry->Hash)];
+	while (*link != index)
+	{
+		assert(*link != NO_ENTRY);
+		link = &Pool[*link].Next;
+	}
+	*link = entry->Next;
+
+	LastFreed++;
+	LiveCount--;
+	StringBytes -= entry->Str.Len() + 1;
+	entry->Next = FREE_ENTRY;
+	entry->Str = "";
+	FreeEntries.Push(index);
+}
+
+//============================================================================
+//
+// ACSStringPool :: Rehash
+//
+// Rebuilds the hash chains with enough buckets to keep them short.
+//
+//============================================================================
+
+void ACSStringPool::Rehash()
+{
+	unsigned int numbuckets = MIN_BUCKETS;
+	while (numbuckets <= LiveCount)
+	{
+		numbuckets <<= 1;
+	}
+	PoolBuckets.Resize(numbuckets);
+	memset(PoolBuckets.Data(), 0xFF, numbuckets * sizeof(unsigned int));
+
+	for (unsigned int i = 0; i < Pool.Size(); ++i)
+	{
+		PoolEntry *entry = &Pool[i];
+		if (entry->Next != FREE_ENTRY)
+		{
+			unsigned int h = Bucket(entry->Hash);
+			entry->Next = PoolBuckets[h];
+			PoolBuckets[h] = i;
+		}
+	}
+}
+
+//============================================================================
+//
+// ACSStringPool :: RebuildFreeList
+//
+// Collects all free entries so that the lowest one gets used first.
+//
+//============================================================================
+
+void ACSStringPool::RebuildFreeList()
+{
+	FreeEntries.Clear();
+	for (unsigned int i = Pool.Size(); i-- > 0; )
+	{
+		if (Pool[i].Next == FREE_ENTRY)
+		{
+			FreeEntries.Push(i);
+		}
+	}
 }
 
 //============================================================================
@@ -1188,9 +1327,9 @@ void ACSStringPool::PurgeStrings()
 //
 //============================================================================
 
-int ACSStringPool::FindString(const char *str, size_t len, unsigned int h, unsigned int bucketnum)
+int ACSStringPool::FindString(const char *str, size_t len, unsigned int h)
 {
-	unsigned int i = PoolBuckets[bucketnum];
+	unsigned int i = PoolBuckets[Bucket(h)];
 	while (i != NO_ENTRY)
 	{
 		PoolEntry *entry = &Pool[i];
@@ -1213,54 +1352,48 @@ int ACSStringPool::FindString(const char *str, size_t len, unsigned int h, unsig
 //
 //============================================================================
 
-int ACSStringPool::InsertString(FString &str, unsigned int h, unsigned int bucketnum)
+int ACSStringPool::InsertString(FString &str, unsigned int h)
 {
-	unsigned int index = FirstFreeEntry;
-	if (index >= MIN_GC_SIZE && index == Pool.Max())
+	if (FreeEntries.Size() == 0 && Pool.Size() >= MIN_GC_SIZE && Pool.Size() == Pool.Max())
 	{ // We will need to grow the array. Try a garbage collection first.
 		P_CollectACSGlobalStrings();
-		index = FirstFreeEntry;
-	}
-	if (FirstFreeEntry >= STRPOOL_LIBRARYID_OR)
-	{ // If we go any higher, we'll collide with the library ID marker.
-		return -1;
 	}
-	if (index == Pool.Size())
-	{ // There were no free entries; make a new one.
-		Pool.Reserve(MIN_GC_SIZE);
-		FirstFreeEntry++;
+	if (FreeEntries.Size() == 0)
+	{
+		if (Pool.Size() >= STRPOOL_LIBRARYID_OR)
+		{ // If we go any higher, we'll collide with the library ID marker.
+			return -1;
+		}
+		// There were no free entries; make some new ones.
+		unsigned int first = Pool.Reserve(MIN_GC_SIZE);
+		for (unsigned int i = Pool.Size(); i-- > first; )
+		{
+			FreeEntries.Push(i);
+		}
 	}
-	else
-	{ // Scan for the next free entry
-		FindFirstFreeEntry(FirstFreeEntry + 1);
+	unsigned int index;
+	FreeEntries.Pop(index);
+
+	if (LiveCount >= PoolBuckets.Size())
+	{ // Keep the chains short.
+		Rehash();
 	}
+
 	PoolEntry *entry = &Pool[index];
+	unsigned int bucketnum = Bucket(h);
 	entry->Str = str;
 	entry->Hash = h;
 	entry->Next = PoolBuckets[bucketnum];
-	entry->Mark = false;
+	entry->Mark = MarkEpoch - 1;
+	entry->Age = 0;
 	entry->Locks.Clear();
 	PoolBuckets[bucketnum] = index;
+	Nursery.Push(index);
+	LiveCount++;
+	StringBytes += str.Len() + 1;
 	return index | STRPOOL_LIBRARYID_OR;
 }
 
-//============================================================================
-//
-// ACSStringPool :: FindFirstFreeEntry
-//
-// Finds the first free entry, starting at base.
-//
-//============================================================================
-
-void ACSStringPool::FindFirstFreeEntry(unsigned base)
-{
-	while (base < Pool.Size() && Pool[base].Next != FREE_ENTRY)
-	{
-		base++;
-	}
-	FirstFreeEntry = base;
-}
-
 //============================================================================
 //
 // ACSStringPool :: ReadStrings
@@ -1282,7 +1415,8 @@ void ACSStringPool::ReadStrings(FSerializer &file, const char *key)
 		for (auto &p : Pool)
 		{
 			p.Next = FREE_ENTRY;
-			p.Mark = false;
+			p.Mark = MarkEpoch - 1;
+			p.Age = PROMOTE_AGE;
 			p.Locks.Clear();
 		}
 		if (file.BeginArray("pool"))
@@ -1294,16 +1428,15 @@ void ACSStringPool::ReadStrings(FSerializer &file, const char *key)
 				{
 					unsigned ii = UINT_MAX;
 					file("index", ii);
-					if (ii < Pool.Size())
+					if (ii < Pool.Size() && Pool[ii].Next == FREE_ENTRY)
 					{
 						file("string", Pool[ii].Str)
 							("locks", Pool[ii].Locks);
 
-						unsigned h = SuperFastHash(Pool[ii].Str.GetChars(), Pool[ii].Str.Len());
-						unsigned bucketnum = h % NUM_BUCKETS;
-						Pool[ii].Hash = h;
-						Pool[ii].Next = PoolBuckets[bucketnum];
-						PoolBuckets[bucketnum] = ii;
+						Pool[ii].Hash = SuperFastHash(Pool[ii].Str.GetChars(), Pool[ii].Str.Len());
+						Pool[ii].Next = NO_ENTRY;
+						LiveCount++;
+						StringBytes += Pool[ii].Str.Len() + 1;
 					}
 					file.EndObject();
 				}
@@ -1311,7 +1444,8 @@ void ACSStringPool::ReadStrings(FSerializer &file, const char *key)
 		}
 	}
 
-	FindFirstFreeEntry(FirstFreeEntry);
+	Rehash();
+	RebuildFreeList();
 }
 
 //============================================================================
@@ -1372,7 +1506,23 @@ void ACSStringPool::Dump() const
 			Printf("%4u. (%2d) \"%s\"\n", i, Pool[i].Locks.Size(), Pool[i].Str.GetChars());
 		}
 	}
-	Printf("First free %u\n", FirstFreeEntry);
+	Printf("%s\n", GetStats().GetChars());
+}
+
+//============================================================================
+//
+// ACSStringPool :: GetStats
+//
+// Occupancy and collection statistics for the ACSStrings stat.
+//
+//============================================================================
+
+FString ACSStringPool::GetStats() const
+{
+	return FStringf("%u strings (%u young), %u of %u slots free, %u buckets, %u KB text\n"
+		"%u minor, %u major collections, %u freed last, %u total",
+		LiveCount, Nursery.Size(), FreeEntries.Size(), Pool.Size(), PoolBuckets.Size(), unsigned((StringBytes + 1023) / 1024),
+		MinorCollections, MajorCollections, LastFreed, TotalFreed);
 }
 
 
@@ -1454,7 +1604,7 @@ void P_CollectACSGlobalStrings()
 	}
 	P_MarkWorldVarStrings();
 	P_MarkGlobalVarStrings();
-	GlobalACSStrings.PurgeStrings();
+	GlobalACSStrings.CollectStrings();
 }
 
 #ifdef _DEBUG
@@ -3410,11 +3560,13 @@ void DACSThinker::Serialize(FSerializer &arc)
 }
 
 cycle_t ACSTime;
+static unsigned int ACSInstructions;	// p-codes executed during the last tic
 
 void DACSThinker::Tick ()
 {
 	ACSTime.Reset();
 	ACSTime.Clock();
+	ACSInstructions = 0;
 	DLevelScript *script = Scripts;
 
 	while (script)
@@ -6842,6 +6994,21 @@ inline int getshort (int *&pc)
 	return res;
 }
 
+// Reads the p-code at pc and advances pc to its first operand.
+inline int getpcode (ACSFormat fmt, int *&pc)
+{
+	if (fmt == ACS_LittleEnhanced)
+	{
+		int pcd = getbyte(pc);
+		if (pcd >= 256-16)
+		{
+			pcd = (256-16) + ((pcd - (256-16)) << 8) + getbyte(pc);
+		}
+		return pcd;
+	}
+	return NEXTWORD;
+}
+
 static bool CharArrayParms(int &capacity, int &offset, int &a, FACSStackMemory& Stack, int &sp, bool ranged)
 {
 	if (ranged)
@@ -6962,6 +7129,22 @@ int DLevelScript::RunScript()
 	int optstart = -1;
 	int temp;
 
+	// Attribute the time until the script stops running to a frame named
+	// after the script and the offset it resumed at.
+	struct FProfileFrame
+	{
+		bool active = false;
+		~FProfileFrame() { if (active) VMProfileLeave(); }
+	} profileframe;
+	if (VMProfiling && state == SCRIPT_Running)
+	{
+		profileframe.active = true;
+		if (VMProfileEnter(activeBehavior, pc))
+		{
+			VMProfileSetName(FStringf("ACS %s@%u", ScriptPresentation(script).GetChars(), activeBehavior->PC2Ofs(pc)));
+		}
+	}
+
 	while (state == SCRIPT_Running)
 	{
 		if (++runaway > 2000000)
@@ -6971,18 +7154,7 @@ int DLevelScript::RunScript()
 			break;
 		}
 
-		if (fmt == ACS_LittleEnhanced)
-		{
-			pcd = getbyte(pc);
-			if (pcd >= 256-16)
-			{
-				pcd = (256-16) + ((pcd - (256-16)) << 8) + getbyte(pc);
-			}
-		}
-		else
-		{
-			pcd = NEXTWORD;
-		}
+		pcd = getpcode(fmt, pc);
 
 		switch (pcd)
 		{
@@ -7374,31 +7546,49 @@ int DLevelScript::RunScript()
 		case PCD_EQ:
 			STACK(2) = (STACK(2) == STACK(1));
 			sp--;
-			break;
+			goto compared;
 
 		case PCD_NE:
 			STACK(2) = (STACK(2) != STACK(1));
 			sp--;
-			break;
+			goto compared;
 
 		case PCD_LT:
 			STACK(2) = (STACK(2) < STACK(1));
 			sp--;
-			break;
+			goto compared;
 
 		case PCD_GT:
 			STACK(2) = (STACK(2) > STACK(1));
 			sp--;
-			break;
+			goto compared;
 
 		case PCD_LE:
 			STACK(2) = (STACK(2) <= STACK(1));
 			sp--;
-			break;
+			goto compared;
 
 		case PCD_GE:
 			STACK(2) = (STACK(2) >= STACK(1));
 			sp--;
+compared:
+			// Nearly every comparison is immediately consumed by a conditional jump,
+			// so take that here instead of going through the dispatcher once more.
+			// The jump still counts as an executed instruction for the runaway check.
+			if (runaway < 2000000)
+			{
+				int *next = pc;
+				int npcd = getpcode(fmt, next);
+				if (npcd == PCD_IFGOTO || npcd == PCD_IFNOTGOTO)
+				{
+					++runaway;
+					if ((STACK(1) != 0) == (npcd == PCD_IFGOTO))
+						pc = activeBehavior->Ofs2PC (LittleLong(*next));
+					else
+						pc = next + 1;
+					sp--;
+				}
+			}
 			break;
 
 		case PCD_ASSIGNSCRIPTVAR:
@@ -10310,6 +10500,8 @@ scriptwait:
  		}
  	}
 
+	ACSInstructions += runaway;
+
 	if (runaway != 0 && InModuleScriptNumber >= 0)
 	{
 		auto scriptptr = activeBehavior->GetScriptPtr(InModuleScriptNumber);
@@ -10891,7 +11083,13 @@ CCMD(acsprofile)
 	}
 }
 
+ADD_STAT(ACSStrings)
+{
+	return GlobalACSStrings.GetStats();
+}
+
 ADD_STAT(ACS)
 {
-	return FStringf("ACS time: %f ms", ACSTime.TimeMS());
+	double ms = ACSTime.TimeMS();
+	return FStringf("ACS time: %f ms, %u p-codes (%.1f M/s)", ms, ACSInstructions, ms > 0 ? ACSInstructions / (ms * 1000.) : 0.);
 }
@@ -111,35 +111,56 @@ public:
 	void MarkStringArray(const int *strnum, unsigned int count);
 	void MarkStringMap(const FWorldGlobalArray &array);
 	void PurgeStrings();
+	void CollectStrings();
 	void Clear();
 	void Dump() const;
+	FString GetStats() const;
 	void UnlockForLevel(int level)	;
 	void ReadStrings(FSerializer &file, const char *key);
 	void WriteStrings(FSerializer &file, const char *key) const;
 
 private:
-	int FindString(const char *str, size_t len, unsigned int h, unsigned int bucketnum);
-	int InsertString(FString &str, unsigned int h, unsigned int bucketnum);
-	void FindFirstFreeEntry(unsigned int base);
-
-	enum { NUM_BUCKETS = 251 };
+	int FindString(const char *str, size_t len, unsigned int h);
+	int InsertString(FString &str, unsigned int h);
+	void FreeEntry(unsigned int index);
+	void SweepNursery();
+	void Rehash();
+	void RebuildFreeList();
+	unsigned int Bucket(unsigned int h) const { return h & (PoolBuckets.Size() - 1); }
+
+	enum { MIN_BUCKETS = 256 };			// Must be a power of 2
 	enum { FREE_ENTRY = 0xFFFFFFFE };	// Stored in PoolEntry's Next field
 	enum { NO_ENTRY = 0xFFFFFFFF };
 	enum { MIN_GC_SIZE = 100 };			// Don't auto-collect until there are this many strings
+	enum { PROMOTE_AGE = 2 };			// Collections a string must survive to leave the nursery
+	enum { MAJOR_GC_INTERVAL = 8 };		// Every nth collection also sweeps the old strings
 	struct PoolEntry
 	{
 		FString Str;
 		unsigned int Hash;
 		unsigned int Next = FREE_ENTRY;
-		bool Mark;
+		unsigned int Mark;				// Marked for the current collection if this equals MarkEpoch
+		uint8_t Age;
 		TArray<int> Locks;
 
 		void Lock(int levelnum);
 		void Unlock(int levelnum);
 	};
 	TArray<PoolEntry> Pool;
-	unsigned int PoolBuckets[NUM_BUCKETS];
-	unsigned int FirstFreeEntry;
+	TArray<unsigned int> PoolBuckets;
+	TArray<unsigned int> FreeEntries;	// Free slots, the one to be used next is last
+	TArray<unsigned int> Nursery;		// Strings that have not yet survived PROMOTE_AGE collections
+	unsigned int MarkEpoch;
+	unsigned int LiveCount;
+	size_t StringBytes;
+
+	unsigned int MinorsSinceMajor;
+
+	// Statistics
+	unsigned int MinorCollections;
+	unsigned int MajorCollections;
+	unsigned int LastFreed;
+	unsigned int TotalFreed;
 };
 extern ACSStringPool GlobalACSStrings;
 
@@ -72,6 +72,12 @@ void P_SetHealthGroupHealth(FHealthGroup* grp, int health)
 		if (lsector->health3dgroup == grp->id)
 			lsector->health3d = health;
 	}
+
+	if (health > 0)
+	{
+		if (grp->lines.Size()) grp->lines[0]->GetLevel()->hasDestructibleGeometry = true;
+		else if (grp->sectors.Size()) grp->sectors[0]->Level->hasDestructibleGeometry = true;
+	}
 }
 
 void P_SetHealthGroupHealth(FLevelLocals *Level, int id, int health)
@@ -300,6 +306,40 @@ void P_InitHealthGroups(FLevelLocals *Level)
 		FHealthGroup* grp = P_GetHealthGroup(Level, groupsInError[i]);
 		Printf(TEXTCOLOR_GOLD "Health group %d is using the highest found health value of %d", groupsInError[i], grp->health);
 	}
+	P_UpdateDestructibleGeometry(Level);
+}
+
+//==========================================================================
+//
+// P_UpdateDestructibleGeometry
+//
+// Checks whether anything in the level can take damage at all so that
+// explosions can skip the line scan in P_GeometryRadiusAttack on the
+// vast majority of maps which do not use this feature.
+// Once set the flag is only cleared by this function, the setters only
+// ever raise it.
+//
+//==========================================================================
+
+void P_UpdateDestructibleGeometry(FLevelLocals *Level)
+{
+	Level->hasDestructibleGeometry = false;
+	for (auto &line : Level->lines)
+	{
+		if (line.health != 0)
+		{
+			Level->hasDestructibleGeometry = true;
+			return;
+		}
+	}
+	for (auto &sec : Level->sectors)
+	{
+		if (sec.healthceiling != 0 || sec.healthfloor != 0 || sec.health3d != 0)
+		{
+			Level->hasDestructibleGeometry = true;
+			return;
+		}
+	}
 }
 
 //==========================================================================
@@ -457,6 +497,9 @@ void P_GeometryRadiusAttack(AActor* bombspot, AActor* bombsource, int bombdamage
 	// now, this is not entirely correct... but sector actions still _do_ require a valid source actor to trigger anything
 	if (!bombspot)
 		return;
+	// nothing in the level can be damaged so there is no need to look at the surrounding lines.
+	if (!bombspot->Level->hasDestructibleGeometry)
+		return;
 	if (!bombsource)
 		bombsource = bombspot;
 
@@ -874,6 +917,10 @@ void P_SerializeHealthGroups(FLevelLocals *Level, FSerializer& arc)
 
 		arc.EndArray();
 	}
+	if (arc.isReading())
+	{
+		P_UpdateDestructibleGeometry(Level);
+	}
 }
 
 // ===================== zscript interface =====================
@@ -1011,6 +1058,7 @@ DEFINE_ACTION_FUNCTION(_Line, SetHealth)
 		newhealth = 0;
 
 	self->health = newhealth;
+	if (newhealth > 0) self->GetLevel()->hasDestructibleGeometry = true;
 	if (self->healthgroup)
 	{
 		FHealthGroup* grp = P_GetHealthGroup(self->GetLevel(), self->healthgroup);
@@ -1071,6 +1119,7 @@ DEFINE_ACTION_FUNCTION(_Sector, SetHealth)
 
 	FHealthGroup* grp = group ? P_GetHealthGroup(self->Level, group) : nullptr;
 	*health = newhealth;
+	if (newhealth > 0) self->Level->hasDestructibleGeometry = true;
 	if (grp) P_SetHealthGroupHealth(grp, newhealth);
 	return 0;
 }
@@ -23,6 +23,7 @@ enum
 
 struct FLevelLocals;
 void P_InitHealthGroups(FLevelLocals *Level);
+void P_UpdateDestructibleGeometry(FLevelLocals *Level);
 
 void P_SetHealthGroupHealth(FHealthGroup* group, int health);
 void P_SetHealthGroupHealth(FLevelLocals *Level, int group, int health);
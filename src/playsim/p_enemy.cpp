@@ -30,6 +30,7 @@
 
 
 #include <stdlib.h>
+#include <algorithm>
 
 
 #include "m_random.h"
@@ -53,6 +54,8 @@
 #include "shadowinlines.h"
 
 #include "gi.h"
+#include "stats.h"
+#include "c_dispatch.h"
 
 static FRandom pr_checkmissilerange ("CheckMissileRange");
 static FRandom pr_opendoor ("OpenDoor");
@@ -936,6 +939,204 @@ void P_DoNewChaseDir (AActor *actor, double deltax, double deltay)
 // hang over dropoffs.
 //=============================================================================
 
+//=============================================================================
+//
+// Flow field chasing
+//
+// On maps with hundreds of monsters chasing the same player, P_NewChaseDir
+// mostly sends them straight at walls where they keep probing directions.
+// With sv_flowfieldchase enabled a shortest path over the sector graph is
+// computed once per tic for every player that is being chased and monsters
+// head for the line leading to the next sector on that path instead.
+// Everything is derived from the current play state, so this is safe for
+// demos and netgames. The default keeps the original behavior.
+//
+//=============================================================================
+
+CVAR(Bool, sv_flowfieldchase, false, CVAR_SERVERINFO | CVAR_ARCHIVE);
+
+struct FFlowField
+{
+	FLevelLocals *Level = nullptr;
+	int maptime = -1;
+	sector_t *source = nullptr;
+	TArray<double> Distance;	// path length to the target's sector, negative if unreachable
+	TArray<line_t *> Exit;		// line to cross to get one sector closer
+};
+
+struct FFlowNode
+{
+	double dist;
+	int sector;
+
+	// Ties are broken by sector index so that the result does not depend on the heap implementation.
+	bool operator<(const FFlowNode &other) const
+	{
+		return dist > other.dist || (dist == other.dist && sector > other.sector);
+	}
+};
+
+static FFlowField FlowFields[MAXPLAYERS];
+
+void P_ClearFlowFields()
+{
+	for (auto &field : FlowFields)
+	{
+		field.Level = nullptr;
+		field.source = nullptr;
+		field.Distance.Reset();
+		field.Exit.Reset();
+	}
+}
+
+//=============================================================================
+//
+// Checks if a monster could pass the line from 'from' into 'to'.
+// This only needs to be a rough approximation, the actual move is
+// still validated by P_TryMove.
+//
+//=============================================================================
+
+static bool P_FlowCanPass(line_t *line, sector_t *from, sector_t *to)
+{
+	if (line->flags & (ML_BLOCKING | ML_BLOCKMONSTERS | ML_BLOCKEVERYTHING)) return false;
+	if (line->flags2 & ML2_BLOCKLANDMONSTERS) return false;
+	if (line->isLinePortal()) return false;
+
+	DVector2 mid = line->v1->fPos() + line->Delta() / 2;
+	double fromfloor = from->floorplane.ZatPoint(mid);
+	double tofloor = to->floorplane.ZatPoint(mid);
+	double top = min(from->ceilingplane.ZatPoint(mid), to->ceilingplane.ZatPoint(mid));
+	double bottom = max(fromfloor, tofloor);
+
+	return top - bottom >= 32 && tofloor - fromfloor <= 24;
+}
+
+//=============================================================================
+//
+// Dijkstra over the sector graph, starting at the target's sector.
+// Edges are weighted with the distance between the sectors' center spots.
+//
+//=============================================================================
+
+static void P_BuildFlowField(FFlowField &field, FLevelLocals *Level, sector_t *source)
+{
+	unsigned numsectors = Level->sectors.Size();
+	field.Level = Level;
+	field.maptime = Level->maptime;
+	field.source = source;
+	field.Distance.Resize(numsectors);
+	field.Exit.Resize(numsectors);
+	for (unsigned i = 0; i < numsectors; i++)
+	{
+		field.Distance[i] = -1;
+		field.Exit[i] = nullptr;
+	}
+
+	TArray<FFlowNode> heap;
+	field.Distance[source->Index()] = 0;
+	heap.Push({ 0, source->Index() });
+
+	while (heap.Size() > 0)
+	{
+		std::pop_heap(&heap[0], &heap[0] + heap.Size());
+		FFlowNode node;
+		heap.Pop(node);
+
+		if (node.dist > field.Distance[node.sector]) continue;	// outdated entry
+
+		sector_t *sec = &Level->sectors[node.sector];
+		for (auto line : sec->Lines)
+		{
+			sector_t *other = getNextSector(line, sec);
+			if (other == nullptr) continue;
+
+			// The monster moves from 'other' into 'sec', i.e. towards the target.
+			if (!P_FlowCanPass(line, other, sec)) continue;
+
+			double dist = node.dist + (other->centerspot - sec->centerspot).Length();
+			double &otherdist = field.Distance[other->Index()];
+			if (otherdist < 0 || dist < otherdist)
+			{
+				otherdist = dist;
+				field.Exit[other->Index()] = line;
+				heap.Push({ dist, other->Index() });
+				std::push_heap(&heap[0], &heap[0] + heap.Size());
+			}
+		}
+	}
+}
+
+//=============================================================================
+//
+// Replaces the chase delta with one towards the exit line of the actor's
+// sector. Returns false if the field cannot help, e.g. the target is in
+// the same sector or there is no known path.
+//
+//=============================================================================
+
+static bool P_FlowFieldDelta(AActor *actor, AActor *target, DVector2 &delta)
+{
+	if (target->player == nullptr || actor->Sector == target->Sector) return false;
+	if (actor->flags & (MF_FLOAT | MF_NOCLIP)) return false;
+
+	auto Level = actor->Level;
+	FFlowField &field = FlowFields[target->player - players];
+	if (field.Level != Level || field.maptime != Level->maptime || field.source != target->Sector)
+	{
+		P_BuildFlowField(field, Level, target->Sector);
+	}
+
+	line_t *exit = field.Exit[actor->Sector->Index()];
+	if (exit == nullptr) return false;
+
+	// Aim at the closest point of the exit line, kept away from its ends, and then a bit beyond it.
+	DVector2 v1 = exit->v1->fPos();
+	DVector2 dir = exit->Delta();
+	double len = dir.Length();
+	if (len <= 0) return false;
+	dir /= len;
+
+	double margin = min(actor->radius, len / 2);
+	double u = clamp((actor->Pos().XY() - v1) | dir, margin, len - margin);
+	DVector2 normal(-dir.Y, dir.X);	// points from the front to the back side
+	if (P_PointOnLineSidePrecise(actor->Pos().XY(), exit) == 1) normal = -normal;
+
+	delta = v1 + dir * u + normal * (actor->radius + 32) - actor->Pos().XY();
+	return true;
+}
+
+//=============================================================================
+//
+// Measures how long building the flow field for the console player takes.
+//
+//=============================================================================
+
+CCMD(bench_flowfield)
+{
+	if (gamestate != GS_LEVEL || players[consoleplayer].mo == nullptr)
+	{
+		Printf("Not in a level\n");
+		return;
+	}
+	int passes = argv.argc() > 1 ? max(1, atoi(argv[1])) : 100;
+	AActor *mo = players[consoleplayer].mo;
+	FFlowField field;
+	cycle_t time;
+	time.Reset();
+	time.Clock();
+	for (int i = 0; i < passes; i++)
+	{
+		P_BuildFlowField(field, mo->Level, mo->Sector);
+	}
+	time.Unclock();
+
+	int reachable = 0;
+	for (auto d : field.Distance) if (d >= 0) reachable++;
+	double ms = time.TimeMS();
+	Printf("%u sectors (%d reachable), %d passes: %.3f ms, %.3f ms per field\n", mo->Level->sectors.Size(), reachable, passes, ms, ms / passes);
+}
+
 //=============================================================================
 //
 // P_NewChaseDir
@@ -958,14 +1159,16 @@ void P_NewChaseDir(AActor * actor)
 	{
 		delta = actor->Vec2To(actor->target);
 
-		if (!(actor->flags6 & MF6_NOFEAR))
+		if (!(actor->flags6 & MF6_NOFEAR) &&
+			((actor->target->player != NULL && (actor->target->player->cheats & CF_FRIGHTENING)) || 
+			(actor->flags4 & MF4_FRIGHTENED) ||
+			(actor->target->flags8 & MF8_FRIGHTENING)))
 		{
-			if ((actor->target->player != NULL && (actor->target->player->cheats & CF_FRIGHTENING)) || 
-				(actor->flags4 & MF4_FRIGHTENED) ||
-				(actor->target->flags8 & MF8_FRIGHTENING))
-			{
-				delta = -delta;
-			}
+			delta = -delta;
+		}
+		else if (sv_flowfieldchase)
+		{
+			P_FlowFieldDelta(actor, actor->target, delta);
 		}
 	}
 	else
@@ -55,6 +55,7 @@ int P_SmartMove (AActor *actor);
 bool P_TryWalk (AActor *actor);
 void P_NewChaseDir (AActor *actor);
 void P_RandomChaseDir(AActor *actor);;
+void P_ClearFlowFields();
 int P_IsVisible(AActor *lookee, AActor *other, INTBOOL allaround, FLookExParams *params);
 
 AActor *P_DropItem (AActor *source, PClassActor *type, int special, int chance);
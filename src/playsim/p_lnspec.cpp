@@ -3538,6 +3538,8 @@ FUNC(LS_Line_SetHealth)
 
 	if (arg1 < 0)
 		arg1 = 0;
+	if (arg1 > 0)
+		Level->hasDestructibleGeometry = true;
 
 	while ((l = itr.Next()) >= 0)
 	{
@@ -3557,6 +3559,8 @@ FUNC(LS_Sector_SetHealth)
 
 	if (arg2 < 0)
 		arg2 = 0;
+	if (arg2 > 0)
+		Level->hasDestructibleGeometry = true;
 
 	while ((s = itr.Next()) >= 0)
 	{
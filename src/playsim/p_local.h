@@ -424,6 +424,18 @@ template<class nodetype, class linktype>
 nodetype* P_DelSecnode(nodetype *, nodetype *linktype::*head);
 
 msecnode_t *P_CreateSecNodeList(AActor *thing, double radius, msecnode_t *sector_list, msecnode_t *sector_t::*seclisthead);
+
+// Counters for the relink stat. These only ever go up.
+struct FRelinkStats
+{
+	unsigned Links;				// LinkToWorld calls
+	unsigned ListsReused;		// relinks that kept the sector lists as they were
+	unsigned NodesAdded;		// sector, render and portal nodes
+	unsigned NodesRemoved;
+	unsigned BlockNodes;		// blockmap nodes linked
+	unsigned BlockNodesReused;	// ... of which came straight from the actor's previous position
+};
+extern FRelinkStats relinkstats;
 double	P_GetMoveFactor(const AActor *mo, double *frictionp);	// phares  3/6/98
 double		P_GetFriction(const AActor *mo, double *frictionfactor);
 
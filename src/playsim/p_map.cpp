@@ -82,6 +82,7 @@
 #include "p_blockmap.h"
 #include "p_3dmidtex.h"
 #include "vm.h"
+#include "stats.h"
 
 #include "decallib.h"
 
@@ -149,9 +150,10 @@ bool P_CanCollideWith(AActor *tmthing, AActor *thing)
 	int retval;
 	ret.IntAt(&retval);
 
+	// The default implementation just returns true.
 	auto clss = tmthing->GetClass();
 	VMFunction *func = clss->Virtuals.Size() > VIndex ? clss->Virtuals[VIndex] : nullptr;
-	if (func != nullptr)
+	if (func != nullptr && !tmthing->NativeVirtual(AVIRT_CanCollideWith))
 	{
 		VMCall(func, params, 3, &ret, 1);
 		if (!retval) return false;
@@ -162,7 +164,7 @@ bool P_CanCollideWith(AActor *tmthing, AActor *thing)
 	// re-get for the other actor.
 	clss = thing->GetClass();
 	func = clss->Virtuals.Size() > VIndex ? clss->Virtuals[VIndex] : nullptr;
-	if (func != nullptr)
+	if (func != nullptr && !thing->NativeVirtual(AVIRT_CanCollideWith))
 	{
 		VMCall(func, params, 3, &ret, 1);
 		if (!retval) return false;
@@ -172,6 +174,8 @@ bool P_CanCollideWith(AActor *tmthing, AActor *thing)
 
 void P_CollidedWith(AActor* const collider, AActor* const collidee)
 {
+	// The default implementation is empty.
+	if (!collider->NativeVirtual(AVIRT_CollidedWith))
 	{
 		IFVIRTUALPTR(collider, AActor, CollidedWith)
 		{
@@ -180,6 +184,7 @@ void P_CollidedWith(AActor* const collider, AActor* const collidee)
 		}
 	}
 
+	if (!collidee->NativeVirtual(AVIRT_CollidedWith))
 	{
 		IFVIRTUALPTR(collidee, AActor, CollidedWith)
 		{
@@ -6103,6 +6108,37 @@ int P_GetRadiusDamage(AActor *self, AActor *thing, int damage, double distance,
 	return newdam;
 }
 
+//==========================================================================
+//
+// Counters for the explosions stat.
+//
+//==========================================================================
+
+static struct FExplosionStats
+{
+	int Explosions;
+	int Candidates;
+	int Targets;
+} explosionstats;
+
+ADD_STAT(explosions)
+{
+	static FExplosionStats last;
+	static int lasttic;
+	FString out;
+	int tics = max(1, gametic - lasttic);
+
+	out.Format("Per tic: %.1f explosions, %.1f things checked, %.1f targets",
+		double(explosionstats.Explosions - last.Explosions) / tics, double(explosionstats.Candidates - last.Candidates) / tics,
+		double(explosionstats.Targets - last.Targets) / tics);
+	if (gametic != lasttic)
+	{
+		last = explosionstats;
+		lasttic = gametic;
+	}
+	return out;
+}
+
 //==========================================================================
 //
 // P_RadiusAttack
@@ -6128,11 +6164,16 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, double
 
 	P_GeometryRadiusAttack(bombspot, bombsource, bombdamage, bombdistance, bombmod, fulldamagedistance);
 
+	// MBF21
+	const auto sourcegroup = bombspot->GetClass()->ActorInfo()->splash_group;
+
 	TArray<AActor*> targets;
 	int count = 0;
+	explosionstats.Explosions++;
 	while ((it.Next(&cres)))
 	{
 		AActor *thing = cres.thing;
+		explosionstats.Candidates++;
 		// Vulnerable actors can be damaged by radius attacks even if not shootable
 		// Used to emulate MBF's vulnerability of non-missile bouncers to explosions.
 		if (!((thing->flags & MF_SHOOTABLE) || (thing->flags6 & MF6_VULNERABLE)))
@@ -6149,9 +6190,7 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, double
 			continue;
 		}
 
-		// MBF21
 		auto targetgroup = thing->GetClass()->ActorInfo()->splash_group;
-		auto sourcegroup = bombspot->GetClass()->ActorInfo()->splash_group;
 		if (targetgroup != 0 && targetgroup == sourcegroup) continue;
 
 		// a much needed option: monsters that fire explosive projectiles cannot 
@@ -6177,6 +6216,7 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, double
 
 		targets.Push(thing);
 	}
+	explosionstats.Targets += targets.Size();
 
 	for (AActor *thing : targets)
 	{
@@ -61,6 +61,7 @@
 
 
 #include <stdlib.h>
+#include <algorithm>
 
 
 #include "m_bbox.h"
@@ -273,6 +274,33 @@ void P_LineOpening (FLineOpening &open, AActor *actor, const line_t *linedef, co
 // THING POSITION SETTING
 //
 
+//==========================================================================
+//
+// UnlinkFromWorld with a context is nearly always followed by LinkToWorld
+// on the same actor. The blockmap nodes it removes are kept here so that
+// LinkToWorld can reuse them. FLinkContext is also a script struct, so this
+// cannot go in there.
+//
+//==========================================================================
+
+static struct FRelinkCache
+{
+	AActor *actor;
+	bool haslists;		// the context holds the actor's sector lists
+	FBlockNode *blocks;
+
+	void Flush()
+	{
+		while (blocks != nullptr)
+		{
+			FBlockNode *next = blocks->NextBlock;
+			blocks->Release();
+			blocks = next;
+		}
+		actor = nullptr;
+	}
+} relinkcache;
+
 //==========================================================================
 //
 // P_UnsetThingPosition
@@ -285,7 +313,13 @@ void P_LineOpening (FLineOpening &open, AActor *actor, const line_t *linedef, co
 
 void AActor::UnlinkFromWorld (FLinkContext *ctx)
 {
-	if (ctx != nullptr) ctx->sector_list = nullptr;
+	relinkcache.Flush();
+	if (ctx != nullptr)
+	{
+		ctx->sector_list = nullptr;
+		relinkcache.actor = this;
+		relinkcache.haslists = false;
+	}
 	if (!(flags & MF_NOSECTOR))
 	{
 		// invisible things don't need to be in sector list
@@ -317,6 +351,7 @@ void AActor::UnlinkFromWorld (FLinkContext *ctx)
 			{
 				ctx->sector_list = touching_sectorlist;
 				ctx->render_list = touching_rendersectors;
+				relinkcache.haslists = true;
 			}
 			else
 			{
@@ -341,7 +376,15 @@ void AActor::UnlinkFromWorld (FLinkContext *ctx)
 			}
 			*(block->PrevActor) = block->NextActor;
 			FBlockNode *next = block->NextBlock;
-			block->Release ();
+			if (ctx != nullptr)
+			{
+				block->NextBlock = relinkcache.blocks;
+				relinkcache.blocks = block;
+			}
+			else
+			{
+				block->Release ();
+			}
 			block = next;
 		}
 		BlockNode = NULL;
@@ -468,6 +511,19 @@ void AActor::LinkToWorld(FLinkContext *ctx, bool spawningmapthing, sector_t *sec
 	Sector = sector;
 	subsector = Level->PointInRenderSubsector(Pos());	// this is from the rendering nodes, not the gameplay nodes!
 	section = subsector->section;
+	relinkstats.Links++;
+
+	// Only use what UnlinkFromWorld left behind if it was for this actor.
+	FBlockNode **reuse = nullptr;
+	bool unmoved = false;
+	if (ctx != nullptr && relinkcache.actor == this)
+	{
+		reuse = &relinkcache.blocks;
+		// If the sector lists were built for the same position and size they can be kept as they are.
+		// Polyobjects are the only lines that can move, so this is only safe without them.
+		unmoved = relinkcache.haslists && LinkSector == sector && LinkPos == Pos().XY() && LinkRadius == radius &&
+			LinkRenderRadius == renderradius && Level->Polyobjects.Size() == 0;
+	}
 
 	if (!(flags & MF_NOSECTOR))
 	{
@@ -494,13 +550,30 @@ void AActor::LinkToWorld(FLinkContext *ctx, bool spawningmapthing, sector_t *sec
 		// When a node is deleted, its sector links (the links starting
 		// at sector_t->touching_thinglist) are broken. When a node is
 		// added, new sector links are created.
-		touching_sectorlist = P_CreateSecNodeList(this, radius, ctx != nullptr? ctx->sector_list : nullptr, &sector_t::touching_thinglist);	// Attach to thing
-		if (renderradius >= 0) touching_rendersectors = P_CreateSecNodeList(this, RenderRadius(), ctx != nullptr ? ctx->render_list : nullptr, &sector_t::touching_renderthings);
+		if (unmoved)
+		{
+			touching_sectorlist = ctx->sector_list;
+			relinkstats.ListsReused++;
+		}
+		else touching_sectorlist = P_CreateSecNodeList(this, radius, ctx != nullptr? ctx->sector_list : nullptr, &sector_t::touching_thinglist);	// Attach to thing
+		if (renderradius >= 0)
+		{
+			if (unmoved) touching_rendersectors = ctx->render_list;
+			else touching_rendersectors = P_CreateSecNodeList(this, RenderRadius(), ctx != nullptr ? ctx->render_list : nullptr, &sector_t::touching_renderthings);
+		}
 		else
 		{
 			touching_rendersectors = nullptr;
 			if (ctx != nullptr) P_DelSeclist(ctx->render_list, &sector_t::touching_renderthings);
 		}
+		LinkSector = sector;
+		LinkPos = Pos().XY();
+		LinkRadius = radius;
+		LinkRenderRadius = renderradius;
+	}
+	else
+	{
+		LinkSector = nullptr;
 	}
 
 
@@ -536,7 +609,7 @@ void AActor::LinkToWorld(FLinkContext *ctx, bool spawningmapthing, sector_t *sec
 					for (int x = x1; x <= x2; ++x)
 					{
 						FBlockNode **link = &Level->blockmap.blocklinks[y*Level->blockmap.bmapwidth + x];
-						FBlockNode *node = FBlockNode::Create(this, x, y, this->Sector->PortalGroup);
+						FBlockNode *node = FBlockNode::Create(this, x, y, this->Sector->PortalGroup, reuse);
 
 						// Link in to block
 						if ((node->NextActor = *link) != NULL)
@@ -556,6 +629,7 @@ void AActor::LinkToWorld(FLinkContext *ctx, bool spawningmapthing, sector_t *sec
 			}
 		}
 	}
+	if (reuse != nullptr) relinkcache.Flush();
 	// Portal links cannot be done unless the level is fully initialized.
 	if (!spawningmapthing) UpdateRenderSectorList();
 }
@@ -1387,6 +1461,29 @@ void FPathTraverse::AddThingIntercepts (int bx, int by, FBlockThingsIterator &it
 }
 
 
+//===========================================================================
+//
+// FPathTraverse :: SortIntercepts
+//
+// Orders this traversal's intercepts once instead of searching for the
+// closest one on every call to Next. Intercepts beyond the end point
+// can never be returned so they get dropped first. The sort is stable
+// so that intercepts at the same distance come out in the order
+// they were added, just like the old linear search did.
+//
+//===========================================================================
+
+void FPathTraverse::SortIntercepts()
+{
+	intercept_t *first = &intercepts[0] + intercept_index;
+	intercept_t *last = &intercepts[0] + intercepts.Size();
+	last = std::stable_partition(first, last, [](const intercept_t &in) { return in.frac <= 1.; });
+	std::stable_sort(first, last, [](const intercept_t &a, const intercept_t &b) { return a.frac < b.frac; });
+	intercept_count = unsigned(last - &intercepts[0]);
+	count = intercept_index;
+	sorted = true;
+}
+
 //===========================================================================
 //
 // FPathTraverse :: Next
@@ -1395,20 +1492,13 @@ void FPathTraverse::AddThingIntercepts (int bx, int by, FBlockThingsIterator &it
 
 intercept_t *FPathTraverse::Next()
 {
-	intercept_t *in = NULL;
-
-	double dist = FLT_MAX;
-	for (unsigned scanpos = intercept_index; scanpos < intercepts.Size (); scanpos++)
+	if (!sorted)
 	{
-		intercept_t *scan = &intercepts[scanpos];
-		if (scan->frac < dist && !scan->done)
-		{
-			dist = scan->frac;
-			in = scan;
-		}
+		if (intercept_index == intercepts.Size()) return NULL;
+		SortIntercepts();
 	}
-	
-	if (dist > 1. || in == NULL) return NULL;	// checked everything in range			
+	if (count >= intercept_count) return NULL;	// checked everything in range
+	intercept_t *in = &intercepts[count++];
 	in->done = true;
 	return in;
 }
@@ -1462,6 +1552,7 @@ void FPathTraverse::init(double x1, double y1, double x2, double y2, int flags,
 	validcount++;
 	intercept_index = intercepts.Size();
 	Startfrac = startfrac;
+	sorted = false;
 
 	if (flags & PT_DELTA)
 	{
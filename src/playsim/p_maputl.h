@@ -373,8 +373,11 @@ protected:
 	divline_t trace;
 	double Startfrac;
 	unsigned int intercept_index;
-	unsigned int intercept_count;
-	unsigned int count;
+	unsigned int intercept_count;	// end of the sorted intercepts in range
+	unsigned int count;				// next intercept to be returned
+	bool sorted;
+
+	void SortIntercepts();
 
 	virtual void AddLineIntercepts(int bx, int by);
 	virtual void AddThingIntercepts(int bx, int by, FBlockThingsIterator &it, bool compatible);
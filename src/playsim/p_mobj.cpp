@@ -1182,6 +1182,7 @@ void AActor::ConversationAnimation (int animnum)
 
 void AActor::CallTouch(AActor *toucher)
 {
+	if (NativeVirtual(AVIRT_Touch)) return;	// empty by default
 	IFVIRTUAL(AActor, Touch)
 	{
 		VMValue params[2] = { (DObject*)this, toucher };
@@ -1341,6 +1342,7 @@ DEFINE_ACTION_FUNCTION_NATIVE(AActor, Grind, Grind)
 
 bool AActor::CallGrind(bool items)
 {
+	if (NativeVirtual(AVIRT_Grind)) return Grind(this, items);
 	IFVIRTUAL(AActor, Grind)
 	{
 		VMValue params[] = { (DObject*)this, items };
@@ -2930,6 +2932,11 @@ DEFINE_ACTION_FUNCTION(AActor, FallAndSink)
 
 void AActor::CallFallAndSink(double grav, double oldfloorz)
 {
+	if (NativeVirtual(AVIRT_FallAndSink))
+	{
+		FallAndSink(grav, oldfloorz);
+		return;
+	}
 	IFVIRTUAL(AActor, FallAndSink)
 	{
 		VMValue params[3] = { (DObject*)this, grav, oldfloorz };
@@ -3199,6 +3206,65 @@ CCMD(utid)
 	}
 }
 
+//==========================================================================
+//
+// bench_actorscan [passes]
+//
+// Times the kind of scan the thinker loop and the blockmap iterators do
+// over every actor in the level (position, size, flags and state), to
+// measure the effect of AActor's memory layout.
+//
+//==========================================================================
+
+CCMD(bench_actorscan)
+{
+	if (gamestate != GS_LEVEL)
+	{
+		Printf("Not in a level\n");
+		return;
+	}
+	int passes = argv.argc() > 1 ? max(1, atoi(argv[1])) : 100;
+	TArray<AActor *> actors;
+	auto it = primaryLevel->GetThinkerIterator<AActor>();
+	AActor *ac;
+	while ((ac = it.Next()))
+	{
+		actors.Push(ac);
+	}
+	if (actors.Size() == 0)
+	{
+		Printf("No actors in level\n");
+		return;
+	}
+
+	cycle_t time;
+	time.Reset();
+	int hits = 0;
+	for (int pass = 0; pass < passes; pass++)
+	{
+		// Use a different probe position each pass so that nothing gets optimized away.
+		auto probe = actors[pass % actors.Size()];
+		DVector3 pos = probe->Pos();
+		double testradius = probe->radius;
+
+		time.Clock();
+		for (auto mo : actors)
+		{
+			if (!(mo->flags & (MF_SOLID | MF_SPECIAL | MF_SHOOTABLE)) || (mo->flags2 & MF2_THRUACTORS) || mo->tics == 0 || mo->state == nullptr) continue;
+			double blockdist = mo->radius + testradius;
+			if (fabs(mo->X() - pos.X) >= blockdist || fabs(mo->Y() - pos.Y) >= blockdist) continue;
+			if (mo->Z() > pos.Z + probe->Height || mo->Top() < pos.Z || mo->floorz > mo->ceilingz || mo->Sector == nullptr) continue;
+			hits++;
+		}
+		time.Unclock();
+	}
+	double ms = time.TimeMS();
+	Printf("%u actors, %d passes: %.3f ms, %.2f ns per actor (%d hits)\n", actors.Size(), passes, ms,
+		ms * 1e6 / (double(passes) * actors.Size()), hits);
+	Printf("sizeof(AActor) = %d, hot data spans bytes %d-%d\n", (int)sizeof(AActor),
+		int((uint8_t*)&actors[0]->snext - (uint8_t*)actors[0]), int((uint8_t*)&actors[0]->validcount + sizeof(int) - (uint8_t*)actors[0]));
+}
+
 //==========================================================================
 //
 // AActor :: GetMissileDamage
@@ -3304,6 +3370,7 @@ DEFINE_ACTION_FUNCTION(AActor, Slam)
 
 bool AActor::CallSlam(AActor *thing)
 {
+	if (NativeVirtual(AVIRT_Slam)) return Slam(thing);
 	IFVIRTUAL(AActor, Slam)
 	{
 		VMValue params[2] = { (DObject*)this, thing };
@@ -3322,6 +3389,7 @@ bool AActor::CallSlam(AActor *thing)
 // This virtual method only exists on the script side.
 int AActor::SpecialMissileHit (AActor *victim)
 {
+	if (NativeVirtual(AVIRT_SpecialMissileHit)) return -1;	// MHIT_DEFAULT
 	IFVIRTUAL(AActor, SpecialMissileHit)
 	{
 		VMValue params[2] = { (DObject*)this, victim };
@@ -3337,6 +3405,7 @@ int AActor::SpecialMissileHit (AActor *victim)
 // This virtual method only exists on the script side.
 int AActor::SpecialBounceHit(AActor* bounceMobj, line_t* bounceLine, secplane_t* bouncePlane)
 {
+	if (NativeVirtual(AVIRT_SpecialBounceHit)) return -1;	// MHIT_DEFAULT
 	IFVIRTUAL(AActor, SpecialBounceHit)
 	{
 		VMValue params[4] = { (DObject*)this, bounceMobj, bounceLine, bouncePlane };
@@ -4441,6 +4510,70 @@ DEFINE_ACTION_FUNCTION(AActor, CheckNoDelay)
 	ACTION_RETURN_BOOL(self->CheckNoDelay());
 }
 
+//==========================================================================
+//
+// AActor :: TryIdleTick
+//
+// Fast path for monsters that are idling in a state, e.g. waiting for
+// A_Look to find a target. If nothing in Tick can have any effect this
+// tic other than counting down the state's duration, do just that and
+// skip the full (VM dispatched) Tick call. The tic on which the state
+// would advance always runs the regular Tick, so action functions and
+// with them all RNG calls happen on exactly the same tic as before.
+//
+// Every condition is rechecked each tic, so anything that would make the
+// actor react - damage, a new target, a state change, being pushed or
+// carried - wakes it up on the next tic automatically.
+//
+// States with infinite duration or the CanRaise flag are never skipped:
+// on skills with monster respawning Tick runs the nightmare respawn check
+// for them every tic, which counts movecount up and calls the RNG.
+//
+//==========================================================================
+
+bool AActor::TryIdleTick()
+{
+	if (tics <= 1 || state->GetCanRaise() || player != nullptr || alternative != nullptr || Inventory != nullptr || target != nullptr ||
+		freezetics > 0 || effects != 0 || health <= 0 || (ObjectFlags & OF_JustSpawned) ||
+		!(flags3 & MF3_ISMONSTER) ||
+		(flags & (MF_CORPSE | MF_MISSILE | MF_SKULLFLY | MF_UNMORPHED | MF_STEALTH)) ||
+		(flags2 & (MF2_BLASTED | MF2_WINDTHRUST)) || (flags4 & (MF4_VFRICTION | MF4_SCROLLMOVE)) ||
+		(flags5 & MF5_NOINTERACTION) || (flags6 & (MF6_KILLED | MF6_TOUCHY)) ||
+		(flags7 & MF7_HANDLENODELAY) || (flags8 & MF8_INSCROLLSEC))
+	{
+		return false;
+	}
+	// Anything that would be picked up by the movement code.
+	if (!Vel.isZero() || Z() != floorz || waterlevel != 0 || boomwaterlevel != 0 || PoisonDurationReceived != 0 ||
+		BlockingMobj != nullptr || MovementBlockingLine != nullptr || Blocking3DFloor != nullptr ||
+		BlockingFloor != nullptr || BlockingCeiling != nullptr)
+	{
+		return false;
+	}
+	// Sector properties that can change the actor without it moving.
+	if (Sector != floorsector || (Sector->Flags & SECF_KILLMONSTERS) || (Sector->MoreFlags & SECMF_UNDERWATER) ||
+		Sector->GetHeightSec() != nullptr || Sector->e->XFloor.ffloors.Size() != 0 || Sector->floorplane.isSlope() ||
+		!Sector->PortalBlocksMovement(sector_t::floor) || !Sector->PortalBlocksMovement(sector_t::ceiling))
+	{
+		return false;
+	}
+	// UpdateRenderSectorList would have nothing to do.
+	if (touching_sectorportallist != nullptr || touching_lineportallist != nullptr || Level->PortalBlockmap.containsLines)
+	{
+		return false;
+	}
+	if (isFrozen() || Level->BotInfo.botnum != 0)
+	{
+		return false;
+	}
+	IFOVERRIDENVIRTUALPTRNAME(this, NAME_Actor, Tick)
+	{
+		return false;
+	}
+	tics--;
+	return true;
+}
+
 //==========================================================================
 //
 // AActor :: CheckSectorTransition
@@ -7500,6 +7633,7 @@ DEFINE_ACTION_FUNCTION(AActor, DoSpecialDamage)
 
 int AActor::CallDoSpecialDamage(AActor *target, int damage, FName damagetype)
 {
+	if (NativeVirtual(AVIRT_DoSpecialDamage)) return DoSpecialDamage(target, damage, damagetype);
 	IFVIRTUAL(AActor, DoSpecialDamage)
 	{
 		// Without the type cast this picks the 'void *' assignment...
@@ -7567,6 +7701,7 @@ DEFINE_ACTION_FUNCTION(AActor, TakeSpecialDamage)
 
 int AActor::CallTakeSpecialDamage(AActor *inflictor, AActor *source, int damage, FName damagetype)
 {
+	if (NativeVirtual(AVIRT_TakeSpecialDamage)) return TakeSpecialDamage(inflictor, source, damage, damagetype);
 	IFVIRTUAL(AActor, TakeSpecialDamage)
 	{
 		VMValue params[5] = { (DObject*)this, inflictor, source, damage, damagetype.GetIndex() };
@@ -27,6 +27,9 @@
 #include "g_levellocals.h"
 #include "p_maputl.h"
 #include "actor.h"
+#include "p_local.h"
+#include "doomstat.h"
+#include "stats.h"
 
 //=============================================================================
 // phares 3/21/98
@@ -36,6 +39,7 @@
 
 msecnode_t *headsecnode = nullptr;
 FMemArena secnodearena;
+FRelinkStats relinkstats;
 
 //=============================================================================
 //
@@ -113,6 +117,7 @@ nodetype *P_AddSecnode(linktype *s, AActor *thing, nodetype *nextnode, nodetype
 	// of the list.
 
 	node = (nodetype*)P_GetSecnode();
+	relinkstats.NodesAdded++;
 
 	// killough 4/4/98, 4/7/98: mark new nodes unvisited.
 	node->visited = 0;
@@ -182,6 +187,7 @@ nodetype *P_DelSecnode(nodetype *node, nodetype *linktype::*listhead)
 		// Return this node to the freelist
 
 		P_PutSecnode((msecnode_t*)node);
+		relinkstats.NodesRemoved++;
 		return tn;
 	}
 	return nullptr;
@@ -210,6 +216,47 @@ void P_DelSeclist(portnode_t *node, portnode_t *FLinePortal::*sechead)
 		node = P_DelSecnode(node, sechead);
 }
 
+//=============================================================================
+//
+// P_MarkSeclist / P_SweepSeclist
+//
+// For updating a node list in place: Mark clears the m_thing fields, then
+// P_AddSecnode sets them again for every node that is still needed and
+// Sweep deletes the rest. This way only the memberships that actually
+// changed are touched.
+//
+//=============================================================================
+
+template<class nodetype>
+static void P_MarkSeclist(nodetype *node)
+{
+	while (node)
+	{
+		node->m_thing = nullptr;
+		node = node->m_tnext;
+	}
+}
+
+template<class nodetype, class linktype>
+static nodetype *P_SweepSeclist(nodetype *list, nodetype *linktype::*listhead)
+{
+	nodetype *node = list;
+	while (node)
+	{
+		if (node->m_thing == nullptr)
+		{
+			if (node == list)
+				list = node->m_tnext;
+			node = P_DelSecnode(node, listhead);
+		}
+		else
+		{
+			node = node->m_tnext;
+		}
+	}
+	return list;
+}
+
 
 //=============================================================================
 // phares 3/14/98
@@ -222,19 +269,12 @@ void P_DelSeclist(portnode_t *node, portnode_t *FLinePortal::*sechead)
 
 msecnode_t *P_CreateSecNodeList(AActor *thing, double radius, msecnode_t *sector_list, msecnode_t *sector_t::*seclisthead)
 {
-	msecnode_t *node;
-
 	// First, clear out the existing m_thing fields. As each node is
 	// added or verified as needed, m_thing will be set properly. When
 	// finished, delete all nodes where m_thing is still nullptr. These
 	// represent the sectors the Thing has vacated.
 
-	node = sector_list;
-	while (node)
-	{
-		node->m_thing = nullptr;
-		node = node->m_tnext;
-	}
+	P_MarkSeclist(sector_list);
 
 	FBoundingBox box(thing->X(), thing->Y(), radius);
 	FBlockLinesIterator it(thing->Level, box);
@@ -272,21 +312,7 @@ msecnode_t *P_CreateSecNodeList(AActor *thing, double radius, msecnode_t *sector
 	// Now delete any nodes that won't be used. These are the ones where
 	// m_thing is still nullptr.
 
-	node = sector_list;
-	while (node)
-	{
-		if (node->m_thing == nullptr)
-		{
-			if (node == sector_list)
-				sector_list = node->m_tnext;
-			node = P_DelSecnode(node, seclisthead);
-		}
-		else
-		{
-			node = node->m_tnext;
-		}
-	}
-	return sector_list;
+	return P_SweepSeclist(sector_list, seclisthead);
 }
 
 //=============================================================================
@@ -330,6 +356,7 @@ portnode_t *P_DelPortalnode(portnode_t *node)
 
 		// Return this node to the freelist (use the same one as for msecnodes, since both types are the same size.)
 		P_PutSecnode(reinterpret_cast<msecnode_t *>(node));
+		relinkstats.NodesRemoved++;
 		return tn;
 	}
 	return nullptr;
@@ -352,6 +379,7 @@ portnode_t *P_AddPortalnode(FLinePortal *s, AActor *thing, portnode_t *nextnode)
 	}
 
 	node = reinterpret_cast<portnode_t*>(P_GetSecnode());
+	relinkstats.NodesAdded++;
 
 	// killough 4/4/98, 4/7/98: mark new nodes unvisited.
 	node->visited = 0;
@@ -385,7 +413,7 @@ void AActor::UpdateRenderSectorList()
 	if (Pos() != OldRenderPos && !(flags & MF_NOSECTOR))
 	{
 		// Only check if the map contains line portals
-		ClearRenderLineList();
+		P_MarkSeclist(touching_lineportallist);
 		if (Level->PortalBlockmap.containsLines && Pos().XY() != OldRenderPos.XY())
 		{
 			int bx = Level->blockmap.GetBlockX(X());
@@ -400,14 +428,16 @@ void AActor::UpdateRenderSectorList()
 					if (p.mType == PORTT_VISUAL) continue;
 					if (inRange(bb, p.mOrigin) && BoxOnLineSide(bb, p.mOrigin))
 					{
-						touching_lineportallist = P_AddPortalnode(&p, this, touching_lineportallist);
+						touching_lineportallist = P_AddSecnode(&p, this, touching_lineportallist, p.lineportal_thinglist);
 					}
 				}
 			}
 		}
+		touching_lineportallist = P_SweepSeclist(touching_lineportallist, &FLinePortal::lineportal_thinglist);
+
 		sector_t *sec = Sector;
 		double lasth = -FLT_MAX;
-		ClearRenderSectorList();
+		P_MarkSeclist(touching_sectorportallist);
 		while (!sec->PortalBlocksMovement(sector_t::ceiling))
 		{
 			double planeh = sec->GetPortalPlaneZ(sector_t::ceiling);
@@ -430,6 +460,7 @@ void AActor::UpdateRenderSectorList()
 			sec = sec->Level->PointInSector(newpos);
 			touching_sectorportallist = P_AddSecnode(sec, this, touching_sectorportallist, sec->sectorportal_thinglist);
 		}
+		touching_sectorportallist = P_SweepSeclist(touching_sectorportallist, &sector_t::sectorportal_thinglist);
 	}
 }
 
@@ -453,11 +484,18 @@ void AActor::ClearRenderLineList()
 
 FBlockNode *FBlockNode::FreeBlocks = nullptr;
 
-FBlockNode *FBlockNode::Create(AActor *who, int x, int y, int group)
+FBlockNode *FBlockNode::Create(AActor *who, int x, int y, int group, FBlockNode **reuse)
 {
 	FBlockNode *block;
 
-	if (FreeBlocks != nullptr)
+	if (reuse != nullptr && *reuse != nullptr)
+	{
+		// Take one of the nodes the actor was just unlinked from.
+		block = *reuse;
+		*reuse = block->NextBlock;
+		relinkstats.BlockNodesReused++;
+	}
+	else if (FreeBlocks != nullptr)
 	{
 		block = FreeBlocks;
 		FreeBlocks = block->NextBlock;
@@ -472,6 +510,7 @@ FBlockNode *FBlockNode::Create(AActor *who, int x, int y, int group)
 	block->PrevActor = nullptr;
 	block->PrevBlock = nullptr;
 	block->NextBlock = nullptr;
+	relinkstats.BlockNodes++;
 	return block;
 }
 
@@ -480,3 +519,28 @@ void FBlockNode::Release()
 	NextBlock = FreeBlocks;
 	FreeBlocks = this;
 }
+
+//===========================================================================
+//
+// relink stat
+//
+//===========================================================================
+
+ADD_STAT(relink)
+{
+	static FRelinkStats last;
+	static int lasttic;
+	FString out;
+	int tics = max(1, gametic - lasttic);
+
+	out.Format("Per tic: %.1f links (%.1f unchanged), %.1f nodes added, %.1f removed, %.1f block nodes (%.1f reused)",
+		double(relinkstats.Links - last.Links) / tics, double(relinkstats.ListsReused - last.ListsReused) / tics,
+		double(relinkstats.NodesAdded - last.NodesAdded) / tics, double(relinkstats.NodesRemoved - last.NodesRemoved) / tics,
+		double(relinkstats.BlockNodes - last.BlockNodes) / tics, double(relinkstats.BlockNodesReused - last.BlockNodesReused) / tics);
+	if (gametic != lasttic)
+	{
+		last = relinkstats;
+		lasttic = gametic;
+	}
+	return out;
+}
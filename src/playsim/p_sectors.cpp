@@ -129,6 +129,11 @@ DEFINE_ACTION_FUNCTION_NATIVE(_Sector, NextSpecialSector, P_NextSpecialSector)
 	ACTION_RETURN_POINTER(P_NextSpecialSector(self, type, nogood));
 }
 
+// The following functions check each neighbouring plane at both vertices
+// of the connecting line. Most planes are flat, in which case the second
+// check sees the same heights as the first and cannot change the result,
+// so it is only done when one of the involved planes is sloped.
+
 //
 // P_FindLowestFloorSurrounding()
 // FIND LOWEST FLOOR HEIGHT IN SURROUNDING SECTORS
@@ -155,11 +160,14 @@ double FindLowestFloorSurrounding (const sector_t *sector, vertex_t **v)
 				floor = ofloor;
 				spot = check->v1;
 			}
-			ofloor = other->floorplane.ZatPoint (check->v2);
-			if (ofloor < floor && ofloor < sector->floorplane.ZatPoint (check->v2))
+			if (other->floorplane.isSlope() || sector->floorplane.isSlope())
 			{
-				floor = ofloor;
-				spot = check->v2;
+				ofloor = other->floorplane.ZatPoint (check->v2);
+				if (ofloor < floor && ofloor < sector->floorplane.ZatPoint (check->v2))
+				{
+					floor = ofloor;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -194,11 +202,14 @@ double FindHighestFloorSurrounding (const sector_t *sector, vertex_t **v)
 				floor = ofloor;
 				spot = check->v1;
 			}
-			ofloor = other->floorplane.ZatPoint (check->v2);
-			if (ofloor > floor)
+			if (other->floorplane.isSlope())
 			{
-				floor = ofloor;
-				spot = check->v2;
+				ofloor = other->floorplane.ZatPoint (check->v2);
+				if (ofloor > floor)
+				{
+					floor = ofloor;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -243,13 +254,16 @@ double FindNextHighestFloor (const sector_t *sector, vertex_t **v)
 				height = ofloor;
 				spot = check->v1;
 			}
-			ofloor = other->floorplane.ZatPoint (check->v2);
-			floor = sector->floorplane.ZatPoint (check->v2);
-			if (ofloor > floor && ofloor - floor < heightdiff && !sector->IsLinked(other, false))
+			if (other->floorplane.isSlope() || sector->floorplane.isSlope())
 			{
-				heightdiff = ofloor - floor;
-				height = ofloor;
-				spot = check->v2;
+				ofloor = other->floorplane.ZatPoint (check->v2);
+				floor = sector->floorplane.ZatPoint (check->v2);
+				if (ofloor > floor && ofloor - floor < heightdiff && !sector->IsLinked(other, false))
+				{
+					heightdiff = ofloor - floor;
+					height = ofloor;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -295,13 +309,16 @@ double FindNextLowestFloor (const sector_t *sector, vertex_t **v)
 				height = ofloor;
 				spot = check->v1;
 			}
-			ofloor = other->floorplane.ZatPoint (check->v2);
-			floor = sector->floorplane.ZatPoint(check->v2);
-			if (ofloor < floor && floor - ofloor < heightdiff && !sector->IsLinked(other, false))
+			if (other->floorplane.isSlope() || sector->floorplane.isSlope())
 			{
-				heightdiff = floor - ofloor;
-				height = ofloor;
-				spot = check->v2;
+				ofloor = other->floorplane.ZatPoint (check->v2);
+				floor = sector->floorplane.ZatPoint(check->v2);
+				if (ofloor < floor && floor - ofloor < heightdiff && !sector->IsLinked(other, false))
+				{
+					heightdiff = floor - ofloor;
+					height = ofloor;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -347,13 +364,16 @@ double FindNextLowestCeiling (const sector_t *sector, vertex_t **v)
 				height = oceil;
 				spot = check->v1;
 			}
-			oceil = other->ceilingplane.ZatPoint(check->v2);
-			ceil = sector->ceilingplane.ZatPoint(check->v2);
-			if (oceil < ceil && ceil - oceil < heightdiff && !sector->IsLinked(other, true))
+			if (other->ceilingplane.isSlope() || sector->ceilingplane.isSlope())
 			{
-				heightdiff = ceil - oceil;
-				height = oceil;
-				spot = check->v2;
+				oceil = other->ceilingplane.ZatPoint(check->v2);
+				ceil = sector->ceilingplane.ZatPoint(check->v2);
+				if (oceil < ceil && ceil - oceil < heightdiff && !sector->IsLinked(other, true))
+				{
+					heightdiff = ceil - oceil;
+					height = oceil;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -399,13 +419,16 @@ double FindNextHighestCeiling (const sector_t *sector, vertex_t **v)
 				height = oceil;
 				spot = check->v1;
 			}
-			oceil = other->ceilingplane.ZatPoint(check->v2);
-			ceil = sector->ceilingplane.ZatPoint(check->v2);
-			if (oceil > ceil && oceil - ceil < heightdiff && !sector->IsLinked(other, true))
+			if (other->ceilingplane.isSlope() || sector->ceilingplane.isSlope())
 			{
-				heightdiff = oceil - ceil;
-				height = oceil;
-				spot = check->v2;
+				oceil = other->ceilingplane.ZatPoint(check->v2);
+				ceil = sector->ceilingplane.ZatPoint(check->v2);
+				if (oceil > ceil && oceil - ceil < heightdiff && !sector->IsLinked(other, true))
+				{
+					heightdiff = oceil - ceil;
+					height = oceil;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -440,11 +463,14 @@ double FindLowestCeilingSurrounding (const sector_t *sector, vertex_t **v)
 				height = oceil;
 				spot = check->v1;
 			}
-			oceil = other->ceilingplane.ZatPoint(check->v2);
-			if (oceil < height)
+			if (other->ceilingplane.isSlope())
 			{
-				height = oceil;
-				spot = check->v2;
+				oceil = other->ceilingplane.ZatPoint(check->v2);
+				if (oceil < height)
+				{
+					height = oceil;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -479,11 +505,14 @@ double FindHighestCeilingSurrounding (const sector_t *sector, vertex_t **v)
 				height = oceil;
 				spot = check->v1;
 			}
-			oceil = other->ceilingplane.ZatPoint(check->v2);
-			if (oceil > height)
+			if (other->ceilingplane.isSlope())
 			{
-				height = oceil;
-				spot = check->v2;
+				oceil = other->ceilingplane.ZatPoint(check->v2);
+				if (oceil > height)
+				{
+					height = oceil;
+					spot = check->v2;
+				}
 			}
 		}
 	}
@@ -581,7 +610,7 @@ sector_t *FindModelFloorSector (sector_t *sect, double floordestheight)
 		sec = getNextSector (check, sect);
 		if (sec != NULL &&
 			(sec->floorplane.ZatPoint(check->v1) == floordestheight ||
-			 sec->floorplane.ZatPoint(check->v2) == floordestheight))
+			 (sec->floorplane.isSlope() && sec->floorplane.ZatPoint(check->v2) == floordestheight)))
 		{
 			return sec;
 		}
@@ -613,7 +642,7 @@ sector_t *FindModelCeilingSector (sector_t *sect, double floordestheight)
 		sec = getNextSector (check, sect);
 		if (sec != NULL &&
 			(sec->ceilingplane.ZatPoint(check->v1) == floordestheight ||
-			 sec->ceilingplane.ZatPoint(check->v2) == floordestheight))
+			 (sec->ceilingplane.isSlope() && sec->ceilingplane.ZatPoint(check->v2) == floordestheight)))
 		{
 			return sec;
 		}
@@ -158,38 +158,37 @@ void FTagManager::AddLineID(int line, int tag)
 //
 //-----------------------------------------------------------------------------
 
-void FTagManager::HashTags()
+void FTagManager::HashItems(TArray<FTagItem> &items, TArray<int> &hash)
 {
-	// add an end marker so we do not need to check for the array's size in the other functions.
-	static FTagItem it = { -1, -1, -1 };
-	allTags.Push(it);
-	allIDs.Push(it);
+	// Fixed size tables got long chains on maps with thousands of tags, so size them to the data.
+	unsigned size = TAG_HASH_MINSIZE;
+	while (size < items.Size()) size <<= 1;
 
 	// Initially make all slots empty.
-	memset(TagHashFirst, -1, sizeof(TagHashFirst));
-	memset(IDHashFirst, -1, sizeof(IDHashFirst));
+	hash.Resize(size);
+	for (auto &h : hash) h = -1;
 
 	// Proceed from last to first so that lower targets appear first
-	for (int i = allTags.Size() - 1; i >= 0; i--)
+	for (int i = items.Size() - 1; i >= 0; i--)
 	{
-		if (allTags[i].target >= 0)	// only link valid entries
+		if (items[i].target >= 0)	// only link valid entries
 		{
-			int hash = ((unsigned int)allTags[i].tag) % FTagManager::TAG_HASH_SIZE;
-			allTags[i].nexttag = TagHashFirst[hash];
-			TagHashFirst[hash] = i;
+			int bucket = ((unsigned int)items[i].tag) & (size - 1);
+			items[i].nexttag = hash[bucket];
+			hash[bucket] = i;
 		}
 	}
+}
 
-	for (int i = allIDs.Size() - 1; i >= 0; i--)
-	{
-		if (allIDs[i].target >= 0)	// only link valid entries
-		{
-			int hash = ((unsigned int)allIDs[i].tag) % FTagManager::TAG_HASH_SIZE;
-			allIDs[i].nexttag = IDHashFirst[hash];
-			IDHashFirst[hash] = i;
-		}
-	}
+void FTagManager::HashTags()
+{
+	// add an end marker so we do not need to check for the array's size in the other functions.
+	static FTagItem it = { -1, -1, -1 };
+	allTags.Push(it);
+	allIDs.Push(it);
 
+	HashItems(allTags, TagHashFirst);
+	HashItems(allIDs, IDHashFirst);
 }
 
 //-----------------------------------------------------------------------------
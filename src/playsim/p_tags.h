@@ -19,7 +19,7 @@ class FTagManager
 {
 	enum
 	{
-		TAG_HASH_SIZE = 256
+		TAG_HASH_MINSIZE = 256
 	};
 
 	// Only the iterators and the map loader, including its helpers may access this. Everything else should go through FLevelLocals's interface.
@@ -34,8 +34,14 @@ class FTagManager
 	TArray<FTagItem> allIDs;
 	TArray<int> startForSector;
 	TArray<int> startForLine;
-	int TagHashFirst[TAG_HASH_SIZE];
-	int IDHashFirst[TAG_HASH_SIZE];
+	TArray<int> TagHashFirst;	// sized to a power of 2 by HashTags
+	TArray<int> IDHashFirst;
+
+	static int HashStart(const TArray<int> &hash, int tag)
+	{
+		return hash.Size() == 0 ? -1 : hash[((unsigned int)tag) & (hash.Size() - 1)];
+	}
+	static void HashItems(TArray<FTagItem> &items, TArray<int> &hash);
 
 	bool SectorHasTags(int sect) const
 	{
@@ -55,8 +61,8 @@ class FTagManager
 		allIDs.Clear();
 		startForSector.Clear();
 		startForLine.Clear();
-		memset(TagHashFirst, -1, sizeof(TagHashFirst));
-		memset(IDHashFirst, -1, sizeof(IDHashFirst));
+		TagHashFirst.Clear();
+		IDHashFirst.Clear();
 	}
 
 	bool SectorHasTags(const sector_t *sector) const;
@@ -101,7 +107,7 @@ protected:
 	void Init(int tag)
 	{
 		searchtag = tag;
-		start = tag == 0 ? 0 : tagManager.TagHashFirst[((unsigned int)tag) % FTagManager::TAG_HASH_SIZE];
+		start = tag == 0 ? 0 : FTagManager::HashStart(tagManager.TagHashFirst, tag);
 	}
 
 	void Init(int tag, line_t *line)
@@ -114,7 +120,7 @@ protected:
 		else
 		{
 			searchtag = tag;
-			start = tagManager.TagHashFirst[((unsigned int)tag) % FTagManager::TAG_HASH_SIZE];
+			start = FTagManager::HashStart(tagManager.TagHashFirst, tag);
 		}
 	}
 
@@ -144,7 +150,7 @@ protected:
 	FLineIdIterator(FTagManager &tm, int id) : tagManager(tm)
 	{
 		searchtag = id;
-		start = tagManager.IDHashFirst[((unsigned int)id) % FTagManager::TAG_HASH_SIZE];
+		start = FTagManager::HashStart(tagManager.IDHashFirst, id);
 	}
 
 public:
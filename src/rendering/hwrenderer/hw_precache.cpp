@@ -298,6 +298,28 @@ void hw_PrecacheTexture(uint8_t *texhitlist, TMap<PClassActor*, bool> &actorhitl
 			}
 		}
 
+		// start upscaling all used images on worker threads so that the upload below can just pick up the results.
+		for (int i = cnt - 1; i >= 0; i--)
+		{
+			auto gtex = TexMan.GameByIndex(i);
+			auto tex = gtex->GetTexture();
+			if (tex != nullptr && tex->GetImage() != nullptr)
+			{
+				if (texhitlist[i] & (FTextureManager::HIT_Wall | FTextureManager::HIT_Flat | FTextureManager::HIT_Sky))
+				{
+					if (shouldUpscale(gtex, UF_Texture) && tex->SystemTextures.GetHardwareTexture(0, CTF_Upscale) == nullptr)
+					{
+						tex->QueueUpscale(CTF_Upscale);
+					}
+				}
+				if (spritehitlist[i] != nullptr && (*spritehitlist[i]).CheckKey(0) && shouldUpscale(gtex, UF_Sprite) &&
+					tex->SystemTextures.GetHardwareTexture(0, CTF_Expand | CTF_Upscale) == nullptr)
+				{
+					tex->QueueUpscale(CTF_Expand | CTF_Upscale);
+				}
+			}
+		}
+
 		// cache all used textures
 		for (int i = cnt - 1; i >= 0; i--)
 		{
@@ -312,6 +334,7 @@ void hw_PrecacheTexture(uint8_t *texhitlist, TMap<PClassActor*, bool> &actorhitl
 			}
 		}
 
+		FlushUpscaleQueue();
 
 		FImageSource::EndPrecaching();
 